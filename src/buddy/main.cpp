@@ -11,6 +11,7 @@
 #include "pccontrol.h"
 #include "routing.h"
 #include "server/clientids.h"
+#include "server/eventstream.h"
 #include "server/httpserver.h"
 #include "server/pairingmanager.h"
 #include "sunshineapps.h"
@@ -175,6 +176,7 @@ std::tuple<int, bool> mainLoop(int argc, char* argv[], const common::AppMetadata
     server::ClientIds      client_ids{QDir::cleanPath(app_meta.getSettingsDir() + "/clients.json")};
     server::HttpServer     new_server{api_version, client_ids};
     server::PairingManager pairing_manager{client_ids, gui_enabled};
+    server::EventStream    event_stream;
 
     const common::AppSettings app_settings{.m_app_metadata = app_meta, .m_user_settings = user_settings};
     PcControl                 pc_control{app_settings};
@@ -220,7 +222,8 @@ std::tuple<int, bool> mainLoop(int argc, char* argv[], const common::AppMetadata
     }
 
     // HERE WE GO!!! (a.k.a. starting point)
-    setupRoutes(new_server, pairing_manager, pc_control, sunshine_apps, user_settings.m_mac_address_override);
+    setupRoutes(new_server, pairing_manager, event_stream, pc_control, sunshine_apps,
+                user_settings.m_mac_address_override);
 
     client_ids.load();
     if (!new_server.startServer(user_settings.m_port, ":/ssl/moondeck_cert.pem", ":/ssl/moondeck_key.pem",
@@ -241,11 +244,18 @@ std::tuple<int, bool> mainLoop(int argc, char* argv[], const common::AppMetadata
                                             return QSsl::SslProtocol::TlsV1_3OrLater;
                                     }
                                     Q_UNREACHABLE();
-                                }(user_settings.m_ssl_protocol)))
+                                }(user_settings.m_ssl_protocol),
+                                std::chrono::seconds{user_settings.m_connection_idle_timeout_sec}))
     {
         qFatal("Failed to start server!");
     }
 
+    QObject::connect(app.get(), &QCoreApplication::aboutToQuit, &sunshine_apps,
+                     [&sunshine_apps]()
+                     {
+                         qCDebug(lc::buddyMain) << "Sunshine apps cache hits:" << sunshine_apps.getCacheHits()
+                                                << "| misses:" << sunshine_apps.getCacheMisses();
+                     });
     QObject::connect(app.get(), &QCoreApplication::aboutToQuit, []() { qCInfo(lc::buddyMain) << "Shutdown."; });
     qCInfo(lc::buddyMain) << "Startup finished.";
     return {QCoreApplication::exec(), restart_into_service};
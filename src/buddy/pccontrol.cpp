@@ -1,6 +1,9 @@
 // header file include
 #include "pccontrol.h"
 
+// system/Qt includes
+#include <QUuid>
+
 // local includes
 #include "common/appsettings.h"
 #include "common/loggingcategories.h"
@@ -13,10 +16,30 @@ PcControl::PcControl(const common::AppSettings& app_settings)
     , m_steam_handler{m_app_settings}
     , m_stream_state_handler{m_app_settings.m_app_metadata.getAppName(common::AppMetadata::App::Stream)}
     , m_shared_env_reader{m_app_settings.m_app_metadata.getSharedEnvMapKey()}
+    , m_generation_epoch{QUuid::createUuid().toString(QUuid::WithoutBraces)}
 {
     connect(&m_steam_handler, &steam::SteamHandler::signalSteamClosed, this, &PcControl::slotHandleSteamClosed);
     connect(&m_stream_state_handler, &StreamStateHandler::signalStreamStateChanged, this,
             &PcControl::slotHandleStreamStateChange);
+
+    // Forwarded for the clients that want to be notified instead of polling
+    connect(&m_pc_state_handler, &os::PcStateHandler::signalPcStateChanged, this, &PcControl::signalPcStateChanged);
+    connect(&m_stream_state_handler, &StreamStateHandler::signalStreamStateChanged, this,
+            &PcControl::signalStreamStateChanged);
+    connect(&m_steam_handler, &steam::SteamHandler::signalAppDataChanged, this, &PcControl::signalAppDataChanged);
+    connect(&m_steam_handler, &steam::SteamHandler::signalSteamUiModeChanged, this,
+            &PcControl::signalSteamUiModeChanged);
+    connect(&m_steam_handler, &steam::SteamHandler::signalCurrentUserChanged, this,
+            &PcControl::signalCurrentUserChanged);
+
+    // The signals are only emitted on actual transitions, so every bump is a real change
+    const auto track_generation{[this](const auto signal, const StateField field)
+                                { connect(this, signal, this, [this, field]() { bumpGeneration(field); }); }};
+    track_generation(&PcControl::signalPcStateChanged, StateField::PcState);
+    track_generation(&PcControl::signalStreamStateChanged, StateField::StreamState);
+    track_generation(&PcControl::signalAppDataChanged, StateField::AppData);
+    track_generation(&PcControl::signalSteamUiModeChanged, StateField::SteamUiMode);
+    track_generation(&PcControl::signalCurrentUserChanged, StateField::CurrentUser);
 }
 
 // For forward declarations
@@ -70,6 +93,11 @@ std::optional<std::map<steam::AppId, QString>> PcControl::getNonSteamAppData(con
     return m_steam_handler.getNonSteamAppData(user_id);
 }
 
+std::optional<std::filesystem::path> PcControl::getNonSteamAppDataPath(const steam::SteamId& user_id) const
+{
+    return m_steam_handler.getNonSteamAppDataPath(user_id);
+}
+
 std::optional<steam::SteamId> PcControl::getCurrentUserId() const
 {
     return m_steam_handler.getCurrentUserId();
@@ -144,6 +172,22 @@ enums::PcState PcControl::getPcState() const
     return m_pc_state_handler.getState();
 }
 
+QString PcControl::getGenerationEpoch() const
+{
+    return m_generation_epoch;
+}
+
+quint64 PcControl::getGeneration() const
+{
+    return m_generation;
+}
+
+quint64 PcControl::getGeneration(const StateField field) const
+{
+    const auto it{m_field_generations.find(field)};
+    return it != std::end(m_field_generations) ? it->second : 0;
+}
+
 void PcControl::setAutoStart(bool enable)
 {
     m_auto_start_handler.setAutoStart(enable);
@@ -164,6 +208,11 @@ bool PcControl::restartIntoService()
     return m_auto_start_handler.restartIntoService();
 }
 
+void PcControl::bumpGeneration(const StateField field)
+{
+    m_field_generations[field] = ++m_generation;
+}
+
 void PcControl::slotHandleSteamClosed()
 {
     if (!m_keep_stream_alive)
@@ -16,6 +16,15 @@ class PcControl : public QObject
     Q_DISABLE_COPY(PcControl)
 
 public:
+    enum class StateField
+    {
+        PcState,
+        StreamState,
+        AppData,
+        SteamUiMode,
+        CurrentUser
+    };
+
     explicit PcControl(const common::AppSettings& app_settings);
     ~PcControl() override;
 
@@ -30,6 +39,7 @@ public:
     bool clearAppData();
 
     std::optional<std::map<steam::AppId, QString>> getNonSteamAppData(const steam::SteamId& user_id) const;
+    std::optional<std::filesystem::path>           getNonSteamAppDataPath(const steam::SteamId& user_id) const;
     std::optional<steam::SteamId>                  getCurrentUserId() const;
 
     bool shutdownPC(uint delay_in_seconds);
@@ -39,6 +49,9 @@ public:
 
     enums::StreamState getStreamState() const;
     enums::PcState     getPcState() const;
+    QString            getGenerationEpoch() const;
+    quint64            getGeneration() const;
+    quint64            getGeneration(StateField field) const;
 
     void setAutoStart(bool enable);
     bool isAutoStartEnabled() const;
@@ -49,12 +62,19 @@ public:
 signals:
     void signalShowTrayMessage(const QString& title, const QString& message, QSystemTrayIcon::MessageIcon icon,
                                int milliseconds_timeout_hint);
+    void signalPcStateChanged();
+    void signalStreamStateChanged();
+    void signalAppDataChanged();
+    void signalSteamUiModeChanged();
+    void signalCurrentUserChanged();
 
 private slots:
     void slotHandleSteamClosed();
     void slotHandleStreamStateChange();
 
 private:
+    void bumpGeneration(StateField field);
+
     const common::AppSettings& m_app_settings;
     os::AutoStartHandler       m_auto_start_handler;
     os::PcStateHandler         m_pc_state_handler;
@@ -64,5 +84,8 @@ private:
     utils::ShmDeserializer m_shared_env_reader;
     QMap<QString, QString> m_cached_env;
 
-    bool m_keep_stream_alive{false};
+    bool                          m_keep_stream_alive{false};
+    QString                       m_generation_epoch;  // Generations are only comparable within the same epoch
+    quint64                       m_generation{0};
+    std::map<StateField, quint64> m_field_generations;
 };
@@ -1,6 +1,11 @@
 // header file include
 #include "routing.h"
 
+// system/Qt includes
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QUrlQuery>
+
 // local includes
 #include "common/loggingcategories.h"
 #include "os/networkinfo.h"
@@ -42,6 +47,19 @@ QHttpServerResponse toResponse(const T& value)
     return QHttpServerResponse{QByteArrayLiteral("application/json"), result.value().toUtf8()};
 }
 
+template<typename T>
+server::EventStream::Event toEvent(const QByteArray& name, const T& value)
+{
+    auto result{json::toJson<T>(value)};
+    if (!result)
+    {
+        qCWarning(lc::buddyMain) << "Failed to encode JSON data for" << name << "event! Reason:\n" << result.error();
+        return {.m_name = name, .m_data = {}};
+    }
+
+    return {.m_name = name, .m_data = result.value().toUtf8()};
+}
+
 template<typename T>
 QHttpServerResponse toResponse(const std::variant<QHttpServerResponse::StatusCode, T>& value)
 {
@@ -55,6 +73,47 @@ QHttpServerResponse toResponse(const std::variant<QHttpServerResponse::StatusCod
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::optional<QByteArray> getFileETag(const QString& filepath, const QByteArray& salt)
+{
+    if (filepath.isEmpty())
+    {
+        return std::nullopt;
+    }
+
+    // Strong tag based on the file identity, so that it can be checked without reading the file
+    const QFileInfo    info{filepath};
+    QCryptographicHash hash{QCryptographicHash::Sha1};
+    hash.addData(salt);
+    hash.addData(filepath.toUtf8());
+    hash.addData(QByteArray::number(info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1));
+    hash.addData(QByteArray::number(info.exists() ? info.size() : -1));
+    return '"' + hash.result().toHex() + '"';
+}
+
+bool matchesETag(const QByteArray& if_none_match, const QByteArray& etag)
+{
+    for (const auto& tag : if_none_match.split(','))
+    {
+        const auto trimmed{tag.trimmed()};
+        if (trimmed == "*" || trimmed == etag || (trimmed.startsWith("W/") && trimmed.sliced(2) == etag))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void addCacheHeaders(QHttpServerResponse& response, const QByteArray& etag)
+{
+    QHttpHeaders headers{response.headers()};
+    headers.append(QHttpHeaders::WellKnownHeader::ETag, etag);
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "private, no-cache");
+    response.setHeaders(std::move(headers));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 template<typename T>
 struct LambdaTraits;
 
@@ -75,45 +134,60 @@ struct LambdaTraits<ReturnT (ObjT::*)() const>
 //----------------------------------------------------------------------------------------------------------------------
 
 template<typename FunctorT>
-auto reqRespFunctorWrapper(const server::HttpServer* authentication_server, const FunctorT& functor)
+auto reqRespFunctorWrapper(server::HttpServer& server, const server::HttpServer::AuthPolicy policy,
+                           const FunctorT& functor)
 {
     using Functor       = std::decay_t<FunctorT>;
     using FunctorTraits = LambdaTraits<decltype(&Functor::operator())>;
     using ArgType       = FunctorTraits::ArgType;
-    using ReturnType    = FunctorTraits::ReturnType;
-
-    const auto authenticator{[authentication_server](const auto& http_request) -> std::optional<QHttpServerResponse>
-                             {
-                                 if (authentication_server && !authentication_server->isAuthorized(http_request))
-                                 {
-                                     return QHttpServerResponse::StatusCode::Unauthorized;
-                                 }
 
-                                 return std::nullopt;
-                             }};
+    // Authorization is checked before dispatching, so that rejected requests never reach the handler
+    const auto is_rejected{[&server, policy](const QHttpServerRequest& http_request)
+                           { return !server.authorize(http_request, policy); }};
 
     if constexpr (std::is_same_v<ArgType, void>)
     {
-        return [authenticator, functor](const QHttpServerRequest& http_request)
-        { return authenticator(http_request).value_or(toResponse<ReturnType>(functor())); };
+        return [is_rejected, functor](const QHttpServerRequest& http_request) -> QHttpServerResponse
+        {
+            if (is_rejected(http_request))
+            {
+                return QHttpServerResponse::StatusCode::Unauthorized;
+            }
+
+            return toResponse(functor());
+        };
     }
     else if constexpr (std::is_same_v<ArgType, QString>)
     {
-        return [authenticator, functor](const QString& arg, const QHttpServerRequest& http_request)
-        { return authenticator(http_request).value_or(toResponse<ReturnType>(functor(arg))); };
+        return [is_rejected, functor](const QString& arg, const QHttpServerRequest& http_request) -> QHttpServerResponse
+        {
+            if (is_rejected(http_request))
+            {
+                return QHttpServerResponse::StatusCode::Unauthorized;
+            }
+
+            return toResponse(functor(arg));
+        };
     }
     else if constexpr (std::is_same_v<ArgType, QHttpServerRequest>)
     {
-        return [authenticator, functor](const QHttpServerRequest& http_request)
-        { return authenticator(http_request).value_or(toResponse<ReturnType>(functor(http_request))); };
+        return [is_rejected, functor](const QHttpServerRequest& http_request) -> QHttpServerResponse
+        {
+            if (is_rejected(http_request))
+            {
+                return QHttpServerResponse::StatusCode::Unauthorized;
+            }
+
+            return toResponse(functor(http_request));
+        };
     }
     else
     {
-        return [authenticator, functor](const QHttpServerRequest& http_request) -> QHttpServerResponse
+        return [is_rejected, functor](const QHttpServerRequest& http_request) -> QHttpServerResponse
         {
-            if (const auto result{authenticator(http_request)})
+            if (is_rejected(http_request))
             {
-                return result->statusCode();
+                return QHttpServerResponse::StatusCode::Unauthorized;
             }
 
             const auto request{fromRequest<ArgType>(http_request)};
@@ -122,30 +196,113 @@ auto reqRespFunctorWrapper(const server::HttpServer* authentication_server, cons
                 return QHttpServerResponse::StatusCode::BadRequest;
             }
 
-            return toResponse<ReturnType>(functor(*request));
+            return toResponse(functor(*request));
         };
     }
 }
 
 template<typename FunctorT>
 void reqRespRouter(server::HttpServer& server, const QString& path_pattern, const QHttpServerRequest::Methods method,
-                   const bool secure, const FunctorT& functor)
+                   const server::HttpServer::AuthPolicy policy, const FunctorT& functor)
 {
-    server.route(path_pattern, method, reqRespFunctorWrapper(secure ? &server : nullptr, functor));
+    server.route(path_pattern, method, reqRespFunctorWrapper(server, policy, functor));
+}
+
+template<typename ETagFunctorT, typename FunctorT>
+void secureCachedReqResp(server::HttpServer& server, const QString& path_pattern,
+                         const QHttpServerRequest::Methods method, const ETagFunctorT& get_etag,
+                         const FunctorT& functor)
+{
+    // Authorization is done here, before the tag is even computed
+    auto handler{reqRespFunctorWrapper(server, server::HttpServer::AuthPolicy::None, functor)};
+    server.route(path_pattern, method,
+                 [&server, get_etag, handler](const QHttpServerRequest& http_request) -> QHttpServerResponse
+                 {
+                     if (!server.authorize(http_request, server::HttpServer::AuthPolicy::ClientId))
+                     {
+                         return QHttpServerResponse::StatusCode::Unauthorized;
+                     }
+
+                     const std::optional<QByteArray> etag{get_etag(http_request)};
+                     if (etag && matchesETag(http_request.value("if-none-match"), *etag))
+                     {
+                         QHttpServerResponse response{QHttpServerResponse::StatusCode::NotModified};
+                         addCacheHeaders(response, *etag);
+                         return response;
+                     }
+
+                     auto response{handler(http_request)};
+                     if (etag && response.statusCode() == QHttpServerResponse::StatusCode::Ok)
+                     {
+                         addCacheHeaders(response, *etag);
+                     }
+                     return response;
+                 });
 }
 
 template<typename FunctorT>
 void openReqResp(server::HttpServer& server, const QString& path_pattern, const QHttpServerRequest::Methods method,
                  FunctorT&& functor)
 {
-    reqRespRouter(server, path_pattern, method, false, std::forward<FunctorT>(functor));
+    reqRespRouter(server, path_pattern, method, server::HttpServer::AuthPolicy::None,
+                  std::forward<FunctorT>(functor));
 }
 
 template<typename FunctorT>
 void secureReqResp(server::HttpServer& server, const QString& path_pattern, const QHttpServerRequest::Methods method,
                    FunctorT&& functor)
 {
-    reqRespRouter(server, path_pattern, method, true, std::forward<FunctorT>(functor));
+    reqRespRouter(server, path_pattern, method, server::HttpServer::AuthPolicy::ClientId,
+                  std::forward<FunctorT>(functor));
+}
+
+template<typename FunctorT>
+void secureStateReqResp(server::HttpServer& server, const QString& path_pattern, const PcControl& pc_control,
+                        const PcControl::StateField field, const FunctorT& functor)
+{
+    // Same as /snapshot, the state is not sent again if it has not changed after `?since=<generation>&epoch=<epoch>`.
+    // The generation is also used as a tag, so that `If-None-Match` works too.
+    auto handler{reqRespFunctorWrapper(server, server::HttpServer::AuthPolicy::None, functor)};
+    server.route(path_pattern, QHttpServerRequest::Method::Get,
+                 [&server, &pc_control, field, handler](const QHttpServerRequest& http_request) -> QHttpServerResponse
+                 {
+                     if (!server.authorize(http_request, server::HttpServer::AuthPolicy::ClientId))
+                     {
+                         return QHttpServerResponse::StatusCode::Unauthorized;
+                     }
+
+                     const auto epoch{pc_control.getGenerationEpoch()};
+                     const auto generation{pc_control.getGeneration(field)};
+                     const auto etag{'"' + epoch.toUtf8() + '-' + QByteArray::number(generation) + '"'};
+
+                     bool            is_unchanged{matchesETag(http_request.value("if-none-match"), etag)};
+                     const QUrlQuery query{http_request.query()};
+                     if (query.hasQueryItem("since"))
+                     {
+                         bool       ok{false};
+                         const auto since{query.queryItemValue("since").toULongLong(&ok)};
+                         if (!ok)
+                         {
+                             return QHttpServerResponse::StatusCode::BadRequest;
+                         }
+
+                         is_unchanged = is_unchanged || (query.queryItemValue("epoch") == epoch && generation <= since);
+                     }
+
+                     auto response{is_unchanged
+                                       ? QHttpServerResponse{QHttpServerResponse::StatusCode::NotModified}
+                                       : handler(http_request)};
+                     if (is_unchanged || response.statusCode() == QHttpServerResponse::StatusCode::Ok)
+                     {
+                         addCacheHeaders(response, etag);
+
+                         QHttpHeaders headers{response.headers()};
+                         headers.append("X-Generation", QByteArray::number(generation));
+                         headers.append("X-Generation-Epoch", epoch.toUtf8());
+                         response.setHeaders(std::move(headers));
+                     }
+                     return response;
+                 });
 }
 }  // namespace
 
@@ -245,8 +402,8 @@ struct PcStateResponse
 
 void pcState(server::HttpServer& server, PcControl& pc_control)
 {
-    secureReqResp(server, "/pcState", QHttpServerRequest::Method::Get,
-                  [&pc_control]() { return PcStateResponse{.m_state = pc_control.getPcState()}; });
+    secureStateReqResp(server, "/pcState", pc_control, PcControl::StateField::PcState,
+                       [&pc_control]() { return PcStateResponse{.m_state = pc_control.getPcState()}; });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -352,12 +509,12 @@ struct SteamUiModeResponse
 
 void steamUiMode(server::HttpServer& server, PcControl& pc_control)
 {
-    secureReqResp(server, "/steamUiMode", QHttpServerRequest::Method::Get,
-                  [&pc_control]()
-                  {
-                      const auto mode{pc_control.getSteamUiMode()};
-                      return SteamUiModeResponse{.m_mode = mode};
-                  });
+    secureStateReqResp(server, "/steamUiMode", pc_control, PcControl::StateField::SteamUiMode,
+                       [&pc_control]()
+                       {
+                           const auto mode{pc_control.getSteamUiMode()};
+                           return SteamUiModeResponse{.m_mode = mode};
+                       });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -380,30 +537,46 @@ struct NonSteamAppDataResponse
 
 void nonSteamAppData(server::HttpServer& server, PcControl& pc_control)
 {
-    secureReqResp(server, "/nonSteamAppData", QHttpServerRequest::Method::Get,
-                  [&pc_control](const NonSteamAppDataRequest& request)
-                      -> std::variant<QHttpServerResponse::StatusCode, NonSteamAppDataResponse>
-                  {
-                      const auto steam_id{steam::SteamId::fromString(request.m_user_id)};
-                      if (!steam_id)
-                      {
-                          return QHttpServerResponse::StatusCode::BadRequest;
-                      }
-
-                      const auto data{pc_control.getNonSteamAppData(*steam_id)};
-                      if (!data)
-                      {
-                          return NonSteamAppDataResponse{.m_data = std::nullopt};
-                      }
-
-                      std::vector<NonSteamAppDataResponse::Entry> entries;
-                      for (const auto& [app_id, app_name] : *data)
-                      {
-                          entries.emplace_back(QString::number(app_id.getGameId()), app_name);
-                      }
-
-                      return NonSteamAppDataResponse{.m_data = std::move(entries)};
-                  });
+    const auto get_etag{[&server, &pc_control](const QHttpServerRequest& http_request) -> std::optional<QByteArray>
+                        {
+                            const auto request{fromRequest<NonSteamAppDataRequest>(http_request)};
+                            const auto steam_id{request ? steam::SteamId::fromString(request->m_user_id)
+                                                        : std::nullopt};
+                            const auto filepath{steam_id ? pc_control.getNonSteamAppDataPath(*steam_id)
+                                                         : std::nullopt};
+                            if (!filepath)
+                            {
+                                return std::nullopt;
+                            }
+
+                            return getFileETag(QString::fromStdString(filepath->generic_string()),
+                                               QByteArray::number(server.getApiVersion()));
+                        }};
+
+    secureCachedReqResp(server, "/nonSteamAppData", QHttpServerRequest::Method::Get, get_etag,
+                        [&pc_control](const NonSteamAppDataRequest& request)
+                            -> std::variant<QHttpServerResponse::StatusCode, NonSteamAppDataResponse>
+                        {
+                            const auto steam_id{steam::SteamId::fromString(request.m_user_id)};
+                            if (!steam_id)
+                            {
+                                return QHttpServerResponse::StatusCode::BadRequest;
+                            }
+
+                            const auto data{pc_control.getNonSteamAppData(*steam_id)};
+                            if (!data)
+                            {
+                                return NonSteamAppDataResponse{.m_data = std::nullopt};
+                            }
+
+                            std::vector<NonSteamAppDataResponse::Entry> entries;
+                            for (const auto& [app_id, app_name] : *data)
+                            {
+                                entries.emplace_back(QString::number(app_id.getGameId()), app_name);
+                            }
+
+                            return NonSteamAppDataResponse{.m_data = std::move(entries)};
+                        });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -418,21 +591,23 @@ struct CurrentUserResponse
     std::optional<UserData> m_user;
 };
 
-void currentUser(server::HttpServer& server, PcControl& pc_control)
+CurrentUserResponse getCurrentUser(const PcControl& pc_control)
 {
-    secureReqResp(server, "/currentUser", QHttpServerRequest::Method::Get,
-                  [&pc_control]()
-                  {
-                      const auto user_id{pc_control.getCurrentUserId()};
-                      if (!user_id)
-                      {
-                          return CurrentUserResponse{.m_user = std::nullopt};
-                      }
+    const auto user_id{pc_control.getCurrentUserId()};
+    if (!user_id)
+    {
+        return CurrentUserResponse{.m_user = std::nullopt};
+    }
 
-                      return CurrentUserResponse{
-                          .m_user = CurrentUserResponse::UserData{
-                              .m_id = user_id->isNull() ? std::nullopt : std::make_optional(user_id->toSteamId64())}};
-                  });
+    return CurrentUserResponse{
+        .m_user = CurrentUserResponse::UserData{
+            .m_id = user_id->isNull() ? std::nullopt : std::make_optional(user_id->toSteamId64())}};
+}
+
+void currentUser(server::HttpServer& server, PcControl& pc_control)
+{
+    secureStateReqResp(server, "/currentUser", pc_control, PcControl::StateField::CurrentUser,
+                       [&pc_control]() { return getCurrentUser(pc_control); });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -516,12 +691,12 @@ struct StreamStateResponse
 
 void streamState(server::HttpServer& server, PcControl& pc_control)
 {
-    secureReqResp(server, "/streamState", QHttpServerRequest::Method::Get,
-                  [&pc_control]()
-                  {
-                      const auto state{pc_control.getStreamState()};
-                      return StreamStateResponse{.m_state = state};
-                  });
+    secureStateReqResp(server, "/streamState", pc_control, PcControl::StateField::StreamState,
+                       [&pc_control]()
+                       {
+                           const auto state{pc_control.getStreamState()};
+                           return StreamStateResponse{.m_state = state};
+                       });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -537,22 +712,23 @@ struct StreamedAppDataResponse
     std::optional<Data> m_data;
 };
 
-void streamedAppData(server::HttpServer& server, PcControl& pc_control)
+StreamedAppDataResponse getStreamedAppData(const PcControl& pc_control)
 {
-    secureReqResp(server, "/streamedAppData", QHttpServerRequest::Method::Get,
-                  [&pc_control]()
-                  {
-                      const auto data{pc_control.getAppData(std::nullopt)};
-                      if (!data)
-                      {
-                          return StreamedAppDataResponse{.m_data = std::nullopt};
-                      }
+    const auto data{pc_control.getAppData(std::nullopt)};
+    if (!data)
+    {
+        return StreamedAppDataResponse{.m_data = std::nullopt};
+    }
 
-                      const auto& [app_id, app_state] = *data;
-                      return StreamedAppDataResponse{
-                          .m_data = StreamedAppDataResponse::Data{.m_app_id    = QString::number(app_id.getId()),
-                                                                  .m_app_state = app_state}};
-                  });
+    const auto& [app_id, app_state] = *data;
+    return StreamedAppDataResponse{.m_data = StreamedAppDataResponse::Data{
+                                       .m_app_id = QString::number(app_id.getId()), .m_app_state = app_state}};
+}
+
+void streamedAppData(server::HttpServer& server, PcControl& pc_control)
+{
+    secureStateReqResp(server, "/streamedAppData", pc_control, PcControl::StateField::AppData,
+                       [&pc_control]() { return getStreamedAppData(pc_control); });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -588,13 +764,129 @@ struct GameStreamAppNamesResponse
 
 void gameStreamAppNames(server::HttpServer& server, SunshineApps& sunshine_apps)
 {
-    secureReqResp(server, "/gameStreamAppNames", QHttpServerRequest::Method::Get,
-                  [&sunshine_apps]() { return GameStreamAppNamesResponse{.m_app_names = sunshine_apps.load()}; });
+    secureCachedReqResp(
+        server, "/gameStreamAppNames", QHttpServerRequest::Method::Get,
+        [&server, &sunshine_apps](const QHttpServerRequest&)
+        { return getFileETag(sunshine_apps.getFilepath(), QByteArray::number(server.getApiVersion())); },
+        [&sunshine_apps]() { return GameStreamAppNamesResponse{.m_app_names = sunshine_apps.load()}; });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct SnapshotResponse
+{
+    QString                                m_epoch;
+    quint64                                m_generation;
+    std::optional<enums::PcState>          m_pc_state;
+    std::optional<enums::StreamState>      m_stream_state;
+    std::optional<StreamedAppDataResponse> m_streamed_app_data;
+    std::optional<enums::SteamUiMode>      m_steam_ui_mode;
+    std::optional<CurrentUserResponse>     m_current_user;
+};
+
+void snapshot(server::HttpServer& server, PcControl& pc_control)
+{
+    secureReqResp(server, "/snapshot", QHttpServerRequest::Method::Get,
+                  [&pc_control](const QHttpServerRequest& request)
+                      -> std::variant<QHttpServerResponse::StatusCode, SnapshotResponse>
+                  {
+                      using enum PcControl::StateField;
+
+                      const QUrlQuery        query{request.query()};
+                      std::optional<quint64> since;
+                      if (query.hasQueryItem("since"))
+                      {
+                          bool ok{false};
+                          since = query.queryItemValue("since").toULongLong(&ok);
+                          if (!ok)
+                          {
+                              return QHttpServerResponse::StatusCode::BadRequest;
+                          }
+                      }
+
+                      // The generations restart from 0 with every run, so the ones handed out by another run (or
+                      // without saying which one) cannot be compared and everything is sent instead
+                      const auto epoch{pc_control.getGenerationEpoch()};
+                      const auto generation{pc_control.getGeneration()};
+                      if (since && (query.queryItemValue("epoch") != epoch || *since > generation))
+                      {
+                          since = std::nullopt;
+                      }
+
+                      // Fields that did not change after the given generation are left as null
+                      const auto changed{[&pc_control, &since](const PcControl::StateField field)
+                                         { return !since || pc_control.getGeneration(field) > *since; }};
+
+                      SnapshotResponse response{.m_epoch = epoch, .m_generation = generation};
+                      if (changed(PcState))
+                      {
+                          response.m_pc_state = pc_control.getPcState();
+                      }
+                      if (changed(StreamState))
+                      {
+                          response.m_stream_state = pc_control.getStreamState();
+                      }
+                      if (changed(AppData))
+                      {
+                          response.m_streamed_app_data = getStreamedAppData(pc_control);
+                      }
+                      if (changed(SteamUiMode))
+                      {
+                          response.m_steam_ui_mode = pc_control.getSteamUiMode();
+                      }
+                      if (changed(CurrentUser))
+                      {
+                          response.m_current_user = getCurrentUser(pc_control);
+                      }
+                      return response;
+                  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void events(server::HttpServer& server, server::EventStream& event_stream, PcControl& pc_control)
+{
+    // Every event carries the same payload as its polling endpoint counterpart
+    const auto pc_state_event{[&pc_control]()
+                              { return toEvent("pcState", PcStateResponse{.m_state = pc_control.getPcState()}); }};
+    const auto stream_state_event{
+        [&pc_control]()
+        { return toEvent("streamState", StreamStateResponse{.m_state = pc_control.getStreamState()}); }};
+    const auto streamed_app_data_event{
+        [&pc_control]() { return toEvent("streamedAppData", getStreamedAppData(pc_control)); }};
+    const auto steam_ui_mode_event{
+        [&pc_control]()
+        { return toEvent("steamUiMode", SteamUiModeResponse{.m_mode = pc_control.getSteamUiMode()}); }};
+
+    server.route("/events", QHttpServerRequest::Method::Get,
+                 [&server, &event_stream, pc_state_event, stream_state_event, streamed_app_data_event,
+                  steam_ui_mode_event](const QHttpServerRequest& request, QHttpServerResponder& responder)
+                 {
+                     if (!server.authorize(request, server::HttpServer::AuthPolicy::ClientId))
+                     {
+                         responder.sendResponse(QHttpServerResponse{QHttpServerResponse::StatusCode::Unauthorized});
+                         return;
+                     }
+
+                     event_stream.subscribe(std::move(responder), server.getConnection(request),
+                                            {pc_state_event(), stream_state_event(), streamed_app_data_event(),
+                                             steam_ui_mode_event()});
+                 });
+
+    QObject::connect(&pc_control, &PcControl::signalPcStateChanged, &event_stream,
+                     [&event_stream, pc_state_event]() { event_stream.publish(pc_state_event()); });
+    QObject::connect(&pc_control, &PcControl::signalStreamStateChanged, &event_stream,
+                     [&event_stream, stream_state_event]() { event_stream.publish(stream_state_event()); });
+    QObject::connect(&pc_control, &PcControl::signalAppDataChanged, &event_stream,
+                     [&event_stream, streamed_app_data_event]() { event_stream.publish(streamed_app_data_event()); });
+    QObject::connect(&pc_control, &PcControl::signalSteamUiModeChanged, &event_stream,
+                     [&event_stream, steam_ui_mode_event]() { event_stream.publish(steam_ui_mode_event()); });
 }
 }  // namespace http_api
 
-void setupRoutes(server::HttpServer& server, server::PairingManager& pairing_manager, PcControl& pc_control,
-                 SunshineApps& sunshine_apps, const QString& mac_address_override)
+void setupRoutes(server::HttpServer& server, server::PairingManager& pairing_manager,
+                 server::EventStream& event_stream, PcControl& pc_control, SunshineApps& sunshine_apps,
+                 const QString& mac_address_override)
 {
     http_api::apiVersion(server);
 
@@ -622,6 +914,9 @@ void setupRoutes(server::HttpServer& server, server::PairingManager& pairing_man
 
     http_api::gameStreamAppNames(server, sunshine_apps);
 
+    http_api::snapshot(server, pc_control);
+    http_api::events(server, event_stream, pc_control);
+
     server.afterRequest(
         [](const QHttpServerRequest& request, const QHttpServerResponse& resp)
         {
@@ -2,9 +2,11 @@
 
 // local includes
 #include "pccontrol.h"
+#include "server/eventstream.h"
 #include "server/httpserver.h"
 #include "server/pairingmanager.h"
 #include "sunshineapps.h"
 
-void setupRoutes(server::HttpServer& server, server::PairingManager& pairing_manager, PcControl& pc_control,
-                 SunshineApps& sunshine_apps, const QString& mac_address_override);
+void setupRoutes(server::HttpServer& server, server::PairingManager& pairing_manager,
+                 server::EventStream& event_stream, PcControl& pc_control, SunshineApps& sunshine_apps,
+                 const QString& mac_address_override);
@@ -3,6 +3,7 @@
 
 // system/Qt includes
 #include <QDir>
+#include <QFileInfo>
 #include <QSettings>
 
 // local includes
@@ -27,6 +28,20 @@ QString getConfigDir()
     return QDir::cleanPath(QDir::homePath() + "/.config");
 }
 #endif
+
+// Places where we could expect the file to exist
+QString getDefaultFilepath()
+{
+#ifdef Q_OS_WIN
+    const QSettings settings(R"(HKEY_LOCAL_MACHINE\Software\LizardByte\Sunshine)", QSettings::NativeFormat);
+    const auto      install_dir{settings.value("Default").toString()};
+    return install_dir.isEmpty() ? QString{} : QDir::cleanPath(install_dir + "/config/apps.json");
+#elifdef Q_OS_LINUX
+    return QDir::cleanPath(getConfigDir() + "/sunshine/apps.json");
+#else
+    #error OS is not supported!
+#endif
+}
 }  // namespace
 
 namespace ext_linkage_for_glaze
@@ -45,28 +60,67 @@ struct AppsJson
 SunshineApps::SunshineApps(QString filepath)
     : m_filepath{std::move(filepath)}
 {
+    connect(&m_file_watcher, &QFileSystemWatcher::fileChanged, this, &SunshineApps::slotInvalidateCache);
+    connect(&m_file_watcher, &QFileSystemWatcher::directoryChanged, this, &SunshineApps::slotInvalidateCache);
+}
+
+QString SunshineApps::getFilepath()
+{
+    if (!m_filepath.isEmpty())
+    {
+        return m_filepath;
+    }
+
+    // The lookup requires reading the registry on Windows, so it is only repeated while there is no file to use
+    // (e.g. Sunshine has been installed or moved in the meantime)
+    if (m_default_filepath.isEmpty() || !QFileInfo::exists(m_default_filepath))
+    {
+        m_default_filepath = getDefaultFilepath();
+    }
+
+    return m_default_filepath;
 }
 
 std::optional<std::set<QString>> SunshineApps::load()
 {
-    QString filepath{m_filepath};
-    if (filepath.isEmpty())  // Fallback to places where we could expect the file to exist
+    const auto filepath{getFilepath()};
+    if (m_cache_valid && m_cached_filepath == filepath)
     {
-#ifdef Q_OS_WIN
-        const QSettings settings(R"(HKEY_LOCAL_MACHINE\Software\LizardByte\Sunshine)", QSettings::NativeFormat);
-        filepath = settings.value("Default").toString();
-        if (!filepath.isEmpty())
-        {
-            filepath = QDir::cleanPath(filepath + "/config/apps.json");
-        }
-#elifdef Q_OS_LINUX
-        filepath = QDir::cleanPath(getConfigDir() + "/sunshine/apps.json");
-#else
-    #error OS is not supported!
-#endif
+        ++m_cache_hits;
+        qCDebug(lc::buddyMain) << "Hit cache for Sunshine apps. Hits:" << m_cache_hits << "| misses:" << m_cache_misses;
+        return m_cached_apps;
     }
 
-    qCDebug(lc::buddyMain) << "Selected filepath for Sunshine apps:" << filepath;
+    ++m_cache_misses;
+    qCDebug(lc::buddyMain) << "Selected filepath for Sunshine apps:" << filepath << "| hits:" << m_cache_hits
+                           << "| misses:" << m_cache_misses;
+
+    // Start watching before reading, so that no modification can slip through in between.
+    // Without a watch nothing would tell us about the changes, so the result cannot be reused.
+    const bool is_watched{watch(filepath)};
+    m_cached_apps     = parse(filepath);
+    m_cached_filepath = filepath;
+    m_cache_valid     = is_watched;
+    return m_cached_apps;
+}
+
+quint64 SunshineApps::getCacheHits() const
+{
+    return m_cache_hits;
+}
+
+quint64 SunshineApps::getCacheMisses() const
+{
+    return m_cache_misses;
+}
+
+void SunshineApps::slotInvalidateCache()
+{
+    m_cache_valid = false;
+}
+
+std::optional<std::set<QString>> SunshineApps::parse(const QString& filepath) const
+{
     if (filepath.isEmpty())
     {
         qCWarning(lc::buddyMain) << "Filepath for Sunshine apps is empty!";
@@ -92,4 +146,38 @@ std::optional<std::set<QString>> SunshineApps::load()
     }
 
     return parsed_apps;
-}
\ No newline at end of file
+}
+
+bool SunshineApps::watch(const QString& filepath)
+{
+    if (const auto watched{m_file_watcher.files() + m_file_watcher.directories()}; !watched.isEmpty())
+    {
+        m_file_watcher.removePaths(watched);
+    }
+
+    if (filepath.isEmpty())
+    {
+        return false;
+    }
+
+    // The directory is watched too, as the file is usually replaced instead of modified in place (or not created yet)
+    const QFileInfo info{filepath};
+    bool            is_watched{false};
+    for (const auto& path : {info.absoluteFilePath(), info.absolutePath()})
+    {
+        if (!QFileInfo::exists(path))
+        {
+            continue;
+        }
+
+        if (m_file_watcher.addPath(path))
+        {
+            is_watched = true;
+            continue;
+        }
+
+        qCDebug(lc::buddyMain) << "could not watch" << path;
+    }
+
+    return is_watched;
+}
@@ -1,19 +1,38 @@
 #pragma once
 
 // system/Qt includes
+#include <QFileSystemWatcher>
 #include <QString>
 #include <set>
 
-class SunshineApps
+class SunshineApps : public QObject
 {
+    Q_OBJECT
     Q_DISABLE_COPY(SunshineApps)
 
 public:
     explicit SunshineApps(QString filepath);
-    virtual ~SunshineApps() = default;
+    ~SunshineApps() override = default;
 
+    QString                          getFilepath();
     std::optional<std::set<QString>> load();
 
+    quint64 getCacheHits() const;
+    quint64 getCacheMisses() const;
+
+private slots:
+    void slotInvalidateCache();
+
 private:
-    QString m_filepath;
+    std::optional<std::set<QString>> parse(const QString& filepath) const;
+    bool                             watch(const QString& filepath);
+
+    QString                          m_filepath;
+    QString                          m_default_filepath;
+    bool                             m_cache_valid{false};
+    std::optional<std::set<QString>> m_cached_apps;
+    QString                          m_cached_filepath;
+    QFileSystemWatcher               m_file_watcher;
+    quint64                          m_cache_hits{0};
+    quint64                          m_cache_misses{0};
 };
@@ -34,6 +34,25 @@ const QString& getConfigDir()
     return config_dir;
 }
 
+const QString& getBaseCacheDir()
+{
+    static const auto cache_dir{[]()
+                                {
+                                    const auto xdg_cache_env = qgetenv("XDG_CACHE_HOME");
+                                    if (!xdg_cache_env.isEmpty())
+                                    {
+                                        const QDir xdg_cache_dir{xdg_cache_env};
+                                        if (xdg_cache_dir.exists())
+                                        {
+                                            return xdg_cache_dir.absolutePath();
+                                        }
+                                    }
+
+                                    return QDir::cleanPath(QDir::homePath() + "/.cache");
+                                }()};
+    return cache_dir;
+}
+
 QString getAppFilePath()
 {
     static const auto app_file_path{[]()
@@ -82,6 +101,7 @@ AppMetadata::AppMetadata(App app)
                            qCDebug(lc::common) << "getSettingsDir() >>" << getSettingsDir();
                            qCDebug(lc::common) << "getSettingsName() >>" << getSettingsName();
                            qCDebug(lc::common) << "getSettingsPath() >>" << getSettingsPath();
+                           qCDebug(lc::common) << "getCacheDir() >>" << getCacheDir();
 
                            for (const auto& value : enums::qEnumValues<AutoStartDelegation>())
                            {
@@ -167,6 +187,19 @@ QString AppMetadata::getSettingsPath() const
     return QDir::cleanPath(getSettingsDir() + "/" + getSettingsName());
 }
 
+// NOLINTNEXTLINE(*-static)
+QString AppMetadata::getCacheDir() const
+{
+#if defined(Q_OS_WIN)
+    Q_ASSERT(QCoreApplication::instance() != nullptr);
+    return QDir::cleanPath(QCoreApplication::applicationDirPath() + "/cache");
+#elif defined(Q_OS_LINUX)
+    return QDir::cleanPath(getBaseCacheDir() + "/" + getAppName(App::Buddy).toLower());
+#else
+    #error OS is not supported!
+#endif
+}
+
 // NOLINTNEXTLINE(*-static)
 QString AppMetadata::getAutoStartDir(const AutoStartDelegation type) const
 {
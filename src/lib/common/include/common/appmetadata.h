@@ -40,6 +40,8 @@ public:
     QString getSettingsName() const;
     QString getSettingsPath() const;
 
+    QString getCacheDir() const;
+
     QString getAutoStartDir(AutoStartDelegation type) const;
     QString getAutoStartName(AutoStartDelegation type) const;
     QString getAutoStartPath(AutoStartDelegation type) const;
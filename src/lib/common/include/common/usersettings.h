@@ -27,7 +27,9 @@ public:
     QString            m_sunshine_apps_filepath;
     bool               m_prefer_hibernation{false};
     SslProtocol        m_ssl_protocol{SslProtocol::SecureProtocols};
+    uint               m_connection_idle_timeout_sec{120};
     bool               m_close_steam_before_sleep{true};
+    uint               m_close_steam_deadline_sec{20};
     QString            m_steam_exec_override;
     QString            m_mac_address_override;
     QRegularExpression m_env_capture_regex{"^(?:SUNSHINE|APOLLO).*"};
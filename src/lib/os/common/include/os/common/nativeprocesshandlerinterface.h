@@ -4,17 +4,40 @@
 #include <QDateTime>
 #include <QString>
 
+// local includes
+#include "os/common/processsnapshot.h"
+
 namespace os
 {
 class NativeProcessHandlerInterface
 {
 public:
+    struct ProcessEvent
+    {
+        enum class Type
+        {
+            Started,
+            Exited,
+            EventsLost,  // Some events were dropped or the source is gone - a full rescan is needed
+        };
+
+        Type m_type;
+        uint m_pid{0};
+    };
+
     virtual ~NativeProcessHandlerInterface() = default;
 
     virtual std::vector<uint> getPids() const              = 0;
+    virtual ProcessSnapshot   getSnapshot() const          = 0;
+    virtual QString           getName(uint pid) const      = 0;
     virtual QString           getExecPath(uint pid) const  = 0;
     virtual QDateTime         getStartTime(uint pid) const = 0;
     virtual void              close(uint pid) const        = 0;
     virtual void              terminate(uint pid) const    = 0;
+
+    // Returns a descriptor that becomes readable once there are events to read or -1 if events are not available
+    virtual int                       startProcessEvents() = 0;
+    virtual void                      stopProcessEvents()  = 0;
+    virtual std::vector<ProcessEvent> readProcessEvents()  = 0;
 };
 }  // namespace os
@@ -0,0 +1,33 @@
+#pragma once
+
+// system/Qt includes
+#include <QDateTime>
+#include <QString>
+#include <vector>
+
+namespace os
+{
+class ProcessSnapshot final
+{
+public:
+    struct Entry
+    {
+        uint      m_pid{0};
+        uint      m_parent_pid{0};
+        QDateTime m_start_time;
+        QString   m_name;
+    };
+
+    explicit ProcessSnapshot(std::vector<Entry> entries = {});
+
+    const std::vector<Entry>& getEntries() const;
+    const Entry*              find(uint pid) const;
+
+    // Returns the PID itself followed by all of its descendants
+    std::vector<uint> getRelatedPids(uint pid) const;
+
+private:
+    std::vector<Entry>                 m_entries;             // Sorted by PID
+    std::vector<std::pair<uint, uint>> m_children_by_parent;  // (parent PID, child PID), sorted
+};
+}  // namespace os
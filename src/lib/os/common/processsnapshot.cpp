@@ -0,0 +1,59 @@
+// header file include
+#include "os/common/processsnapshot.h"
+
+// system/Qt includes
+#include <algorithm>
+#include <set>
+
+namespace os
+{
+ProcessSnapshot::ProcessSnapshot(std::vector<Entry> entries)
+    : m_entries{std::move(entries)}
+{
+    std::ranges::sort(m_entries, {}, &Entry::m_pid);
+
+    m_children_by_parent.reserve(m_entries.size());
+    for (const auto& entry : m_entries)
+    {
+        // Is this even possible? To be your own parent?
+        if (entry.m_pid != entry.m_parent_pid)
+        {
+            m_children_by_parent.emplace_back(entry.m_parent_pid, entry.m_pid);
+        }
+    }
+    std::ranges::sort(m_children_by_parent);
+}
+
+const std::vector<ProcessSnapshot::Entry>& ProcessSnapshot::getEntries() const
+{
+    return m_entries;
+}
+
+const ProcessSnapshot::Entry* ProcessSnapshot::find(const uint pid) const
+{
+    const auto it{std::ranges::lower_bound(m_entries, pid, {}, &Entry::m_pid)};
+    return it != std::end(m_entries) && it->m_pid == pid ? &*it : nullptr;
+}
+
+std::vector<uint> ProcessSnapshot::getRelatedPids(const uint pid) const
+{
+    std::vector<uint> related_pids{pid};
+    std::set<uint>    visited{pid};
+
+    // Start searching for children from current pid
+    for (std::size_t i = 0; i < related_pids.size(); ++i)
+    {
+        const uint related_pid{related_pids[i]};
+        const auto first_child{std::ranges::lower_bound(m_children_by_parent, std::make_pair(related_pid, 0u))};
+        for (auto it = first_child; it != std::end(m_children_by_parent) && it->first == related_pid; ++it)
+        {
+            if (visited.insert(it->second).second)
+            {
+                related_pids.push_back(it->second);
+            }
+        }
+    }
+
+    return related_pids;
+}
+}  // namespace os
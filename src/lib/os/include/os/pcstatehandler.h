@@ -27,10 +27,14 @@ public:
     bool suspendPC(uint grace_period_in_sec);
     bool hibernatePC(uint grace_period_in_sec);
 
+signals:
+    void signalPcStateChanged();
+
 private:
     using NativeMethod = bool (NativePcStateHandlerInterface::*)();
     bool doChangeState(uint grace_period_in_sec, const QString& cant_do_entry, const QString& failed_to_do_entry,
                        NativeMethod can_do_method, NativeMethod do_method, enums::PcState new_state);
+    void setState(enums::PcState state);
 
     enums::PcState                                 m_state{enums::PcState::Normal};
     std::unique_ptr<NativePcStateHandlerInterface> m_native_handler;
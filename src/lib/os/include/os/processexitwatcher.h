@@ -0,0 +1,47 @@
+#pragma once
+
+// system/Qt includes
+#include <QObject>
+#include <map>
+
+// forward declarations
+class QSocketNotifier;
+
+namespace os
+{
+class ProcessExitWatcher : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(ProcessExitWatcher)
+
+public:
+    enum class WatchResult
+    {
+        Watching,
+        NotRunning,
+        Unsupported
+    };
+    Q_ENUM(WatchResult)
+
+    explicit ProcessExitWatcher() = default;
+    ~ProcessExitWatcher() override;
+
+    WatchResult watch(uint pid);
+    void        unwatch(uint pid);
+    bool        isWatching(uint pid) const;
+
+    std::vector<uint> getPids() const;
+
+signals:
+    void signalProcessExited(uint pid);
+
+private:
+    struct Watch
+    {
+        int              m_fd{-1};
+        QSocketNotifier* m_notifier{nullptr};
+    };
+
+    std::map<uint, Watch> m_watches;
+};
+}  // namespace os
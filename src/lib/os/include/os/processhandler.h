@@ -2,8 +2,10 @@
 
 // local includes
 #include "common/enums.h"
+#include "os/common/processsnapshot.h"
 
 // forward declarations
+class QSocketNotifier;
 namespace os
 {
 class NativeProcessHandlerInterface;
@@ -21,12 +23,27 @@ public:
     ~ProcessHandler() override;
 
     std::vector<uint> getPids() const;
+    ProcessSnapshot   getSnapshot() const;
+    QString           getName(uint pid) const;
     QString           getExecPath(uint pid) const;
     QDateTime         getStartTime(uint pid) const;
     void              close(uint pid) const;
     void              terminate(uint pid) const;
 
+    bool startMonitoring();
+    void stopMonitoring();
+    bool isMonitoring() const;
+
+signals:
+    void signalProcessStarted(uint pid);
+    void signalProcessExited(uint pid);
+    void signalProcessEventsLost();
+
+private slots:
+    void slotHandleProcessEvents();
+
 private:
     std::unique_ptr<NativeProcessHandlerInterface> m_native_handler;
+    std::unique_ptr<QSocketNotifier>               m_event_notifier;
 };
 }  // namespace os
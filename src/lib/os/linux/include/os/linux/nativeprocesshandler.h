@@ -10,13 +10,22 @@ class NativeProcessHandler : public NativeProcessHandlerInterface
     Q_DISABLE_COPY(NativeProcessHandler)
 
 public:
-    explicit NativeProcessHandler()  = default;
-    ~NativeProcessHandler() override = default;
+    explicit NativeProcessHandler() = default;
+    ~NativeProcessHandler() override;
 
     std::vector<uint> getPids() const override;
+    ProcessSnapshot   getSnapshot() const override;
+    QString           getName(uint pid) const override;
     QString           getExecPath(uint pid) const override;
     QDateTime         getStartTime(uint pid) const override;
     void              close(uint pid) const override;
     void              terminate(uint pid) const override;
+
+    int                       startProcessEvents() override;
+    void                      stopProcessEvents() override;
+    std::vector<ProcessEvent> readProcessEvents() override;
+
+private:
+    int m_event_fd{-1};
 };
 }  // namespace os
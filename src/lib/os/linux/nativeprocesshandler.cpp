@@ -3,13 +3,22 @@
 
 // system/Qt includes
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <csignal>
+#include <cstring>
 #include <libproc2/pids.h>
 #include <libproc2/stat.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <set>
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 // local includes
 #include "common/loggingcategories.h"
@@ -72,27 +81,79 @@ ItemValue getPidItem(const uint pid, const pids_item item, const ItemValue& fall
     return std::forward<Getter>(getter)(head_ptr->result);
 }
 
-uint getParentPid(const uint pid)
+QDateTime toStartTime(const double seconds_since_boot)
 {
-    return getPidItem(pid, PIDS_ID_PPID, 0u,
-                      [](const auto& result) { return result.s_int >= 0 ? static_cast<uint>(result.s_int) : 0u; });
+    const auto boot_time{getBootTime()};
+    if (!boot_time)
+    {
+        return QDateTime{};
+    }
+
+    const auto milliseconds{static_cast<int>(std::round(seconds_since_boot * 1000.0))};
+    const auto datetime{QDateTime::fromSecsSinceEpoch(*boot_time)};
+    return datetime.addMSecs(milliseconds);
 }
 
 QDateTime getStartTime(const uint pid)
 {
     return getPidItem(pid, PIDS_TIME_START, QDateTime{},
-                      [](const auto& result)
-                      {
-                          const auto boot_time{getBootTime()};
-                          if (!boot_time)
-                          {
-                              return QDateTime{};
-                          }
+                      [](const auto& result) { return toStartTime(result.real); });
+}
+
+os::ProcessSnapshot getSnapshot()
+{
+    enum ItemIndex : std::size_t
+    {
+        Pid,
+        ParentPid,
+        StartTime,
+        Name
+    };
+    std::array items{PIDS_ID_PID, PIDS_ID_PPID, PIDS_TIME_START, PIDS_CMD};
+
+    pids_info* info{nullptr};
+    if (const int error = procps_pids_new(&info, items.data(), items.size()); error < 0)
+    {
+        qWarning(lc::os) << "Failed at procps_pids_new -" << lc::getErrorString(error * -1);
+        return os::ProcessSnapshot{};
+    }
+
+    const auto cleanup{qScopeGuard([&]() { procps_pids_unref(&info); })};
+
+    // A single pass over /proc instead of a separate context for each PID
+    const auto* result{procps_pids_reap(info, PIDS_FETCH_TASKS_ONLY)};
+    if (!result || !result->counts)
+    {
+        qWarning(lc::os) << "Failed at procps_pids_reap -" << lc::getErrorString(errno);
+        return os::ProcessSnapshot{};
+    }
+
+    std::vector<os::ProcessSnapshot::Entry> entries;
+    entries.reserve(static_cast<std::size_t>(std::max(result->counts->total, 0)));
+
+    for (int i = 0; i < result->counts->total; ++i)
+    {
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        const auto* head{result->stacks[i]->head};
+        // NOLINTBEGIN(*-pointer-arithmetic)
+        const auto pid{head[ItemIndex::Pid].result.s_int};
+        const auto parent_pid{head[ItemIndex::ParentPid].result.s_int};
+        const auto start_time{head[ItemIndex::StartTime].result.real};
+        const auto* name{head[ItemIndex::Name].result.str};
+        // NOLINTEND(*-pointer-arithmetic)
+
+        if (pid <= 0)
+        {
+            continue;
+        }
+
+        entries.push_back({.m_pid        = static_cast<uint>(pid),
+                           .m_parent_pid = parent_pid > 0 ? static_cast<uint>(parent_pid) : 0u,
+                           .m_start_time = toStartTime(start_time),
+                           .m_name       = name ? QString::fromLocal8Bit(name) : QString{}});
+    }
 
-                          const auto milliseconds{static_cast<int>(std::round((result.real) * 1000.0))};
-                          const auto datetime{QDateTime::fromSecsSinceEpoch(*boot_time)};
-                          return datetime.addMSecs(milliseconds);
-                      });
+    return os::ProcessSnapshot{std::move(entries)};
 }
 
 std::vector<uint> getPids()
@@ -119,57 +180,213 @@ std::vector<uint> getPids()
     return pids;
 }
 
-std::vector<uint> getParentPids(const std::vector<uint>& pids)
+std::optional<QString> getCgroupDir(const uint pid)
+{
+    QFile file{"/proc/" + QString::number(pid) + "/cgroup"};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+
+    // Only the unified (v2) hierarchy is supported
+    for (const auto& line : file.readAll().split('\n'))
+    {
+        if (line.startsWith("0::"))
+        {
+            const auto path{QString::fromUtf8(line.mid(3))};
+            if (path.isEmpty() || path == "/")
+            {
+                return std::nullopt;
+            }
+
+            return QDir::cleanPath("/sys/fs/cgroup/" + path);
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::vector<uint> getCgroupPids(const QString& cgroup_dir)
 {
-    std::vector<uint> parent_pids;
-    std::transform(std::cbegin(pids), std::cend(pids), std::back_inserter(parent_pids), getParentPid);
-    return parent_pids;
+    QFile file{cgroup_dir + "/cgroup.procs"};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+
+    std::vector<uint> pids;
+    for (const auto& line : file.readAll().split('\n'))
+    {
+        bool       converted{false};
+        const uint pid{line.toUInt(&converted)};
+        if (converted && pid != 0)
+        {
+            pids.push_back(pid);
+        }
+    }
+    return pids;
 }
 
-std::vector<uint> getRelatedPids(uint pid)
+// Returns the cgroup of the process if it contains nothing but the process tree started by Steam (e.g. a systemd
+// scope created by the desktop environment), so that the whole group can be signaled at once. The name of the group
+// is not trusted, as session units (e.g. "gamescope-session-plus@steam.service") also contain the whole desktop.
+std::optional<QString> getDedicatedCgroupDir(const uint pid)
 {
-    const std::vector<uint> all_pids{getPids()};
-    const std::vector<uint> parent_pids{getParentPids(all_pids)};
+    const auto cgroup_dir{getCgroupDir(pid)};
+    if (!cgroup_dir)
+    {
+        return std::nullopt;
+    }
 
-    Q_ASSERT(all_pids.size() == parent_pids.size());
-    std::vector<uint> related_pids;
+    // Never take ourselves down too
+    const auto own_cgroup_dir{getCgroupDir(static_cast<uint>(getpid()))};
+    if (own_cgroup_dir && (*own_cgroup_dir == *cgroup_dir || own_cgroup_dir->startsWith(*cgroup_dir + "/")))
+    {
+        return std::nullopt;
+    }
+
+    // The group would also affect the nested groups that we know nothing about
+    if (!QDir{*cgroup_dir}.entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty())
+    {
+        return std::nullopt;
+    }
 
-    // Start searching for children from current pid
-    related_pids.push_back(pid);
+    // The members have to be read before the snapshot so that newly forked processes are part of the latter
+    const auto     members{getCgroupPids(*cgroup_dir)};
+    const auto     snapshot{getSnapshot()};
+    std::set<uint> member_set{std::begin(members), std::end(members)};
 
-    for (std::size_t i = 0; i < related_pids.size(); ++i)
+    // Find the process that started everything in the group (e.g. the launcher script)
+    uint root_pid{pid};
+    for (std::size_t i = 0; i < snapshot.getEntries().size(); ++i)
     {
-        const uint related_pid{related_pids[i]};
-        for (std::size_t k = 0; k < parent_pids.size(); ++k)
+        const auto* entry{snapshot.find(root_pid)};
+        if (!entry || !member_set.contains(entry->m_parent_pid))
         {
-            const uint parent_pid{parent_pids[k]};
-            if (related_pid != parent_pid)
-            {
-                continue;
-            }
+            break;
+        }
 
-            const uint process_pid{all_pids[k]};
-            if (process_pid == related_pid)
+        root_pid = entry->m_parent_pid;
+    }
+
+    const auto* root_entry{snapshot.find(root_pid)};
+    if (!root_entry || !root_entry->m_name.contains("steam", Qt::CaseInsensitive))
+    {
+        return std::nullopt;
+    }
+
+    auto related_pids{snapshot.getRelatedPids(root_pid)};
+    std::ranges::sort(related_pids);
+    if (!std::ranges::all_of(members, [&related_pids](const uint member)
+                             { return std::ranges::binary_search(related_pids, member); }))
+    {
+        return std::nullopt;
+    }
+
+    return cgroup_dir;
+}
+
+void signalProcesses(const std::vector<uint>& pids, const int signal)
+{
+    for (const auto pid : pids)
+    {
+        if (kill(static_cast<pid_t>(pid), signal) < 0)
+        {
+            const auto error{errno};
+            if (error != ESRCH)
             {
-                // Is this even possible? To be your own parent?
-                continue;
+                qWarning(lc::os) << "Failed to send signal" << signal << "to process" << pid << "-"
+                                 << lc::getErrorString(error);
             }
-
-            related_pids.push_back(process_pid);
         }
     }
+}
 
-    return related_pids;
+int openProcConnector()
+{
+    const int fd{socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR)};
+    if (fd < 0)
+    {
+        qCInfo(lc::os) << "Process events are not available -" << lc::getErrorString(errno);
+        return -1;
+    }
+
+    auto cleanup{qScopeGuard([fd]() { ::close(fd); })};
+
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+    address.nl_pid    = 0;
+
+    // NOLINTNEXTLINE(*-reinterpret-cast)
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        // Joining the process connector group requires CAP_NET_ADMIN
+        qCInfo(lc::os) << "Process events are not available -" << lc::getErrorString(errno);
+        return -1;
+    }
+
+    // `cn_msg` ends with a flexible array member, so the message is assembled in a plain buffer instead of a struct
+    constexpr std::size_t payload_size{sizeof(cn_msg) + sizeof(proc_cn_mcast_op)};
+    alignas(NLMSG_ALIGNTO) std::array<char, NLMSG_SPACE(payload_size)> buffer{};
+
+    nlmsghdr header{};
+    header.nlmsg_len  = NLMSG_LENGTH(payload_size);
+    header.nlmsg_type = NLMSG_DONE;
+    header.nlmsg_pid  = static_cast<__u32>(getpid());
+
+    cn_msg message{};
+    message.id.idx = CN_IDX_PROC;
+    message.id.val = CN_VAL_PROC;
+    message.len    = sizeof(proc_cn_mcast_op);
+
+    const proc_cn_mcast_op operation{PROC_CN_MCAST_LISTEN};
+
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(NLMSG_DATA(buffer.data()), &message, sizeof(message));
+    // NOLINTNEXTLINE(*-pointer-arithmetic)
+    std::memcpy(static_cast<char*>(NLMSG_DATA(buffer.data())) + sizeof(message), &operation, sizeof(operation));
+
+    if (send(fd, buffer.data(), header.nlmsg_len, 0) < 0)
+    {
+        qCInfo(lc::os) << "Process events are not available -" << lc::getErrorString(errno);
+        return -1;
+    }
+
+    cleanup.dismiss();
+    return fd;
 }
 }  // namespace
 
 namespace os
 {
+NativeProcessHandler::~NativeProcessHandler()
+{
+    stopProcessEvents();
+}
+
 std::vector<uint> NativeProcessHandler::getPids() const
 {
     return ::getPids();
 }
 
+ProcessSnapshot NativeProcessHandler::getSnapshot() const
+{
+    return ::getSnapshot();
+}
+
+QString NativeProcessHandler::getName(uint pid) const
+{
+    // A single small read, unlike resolving the executable or the start time
+    QFile file{"/proc/" + QString::number(pid) + "/comm"};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+
+    return QString::fromLocal8Bit(file.readAll().trimmed());
+}
+
 QString NativeProcessHandler::getExecPath(uint pid) const
 {
     const QFileInfo info{"/proc/" + QString::number(pid) + "/exe"};
@@ -183,33 +400,137 @@ QDateTime NativeProcessHandler::getStartTime(uint pid) const
 
 void NativeProcessHandler::close(uint pid) const
 {
-    const auto related_pids{getRelatedPids(pid)};
-    for (const auto related_pid : related_pids)
+    if (const auto cgroup_dir{getDedicatedCgroupDir(pid)})
+    {
+        // Every member is known to be part of the Steam process tree, but this also reaches the processes that
+        // have been forked since the snapshot was taken
+        qCDebug(lc::os) << "Closing all processes in" << *cgroup_dir;
+        signalProcesses(getCgroupPids(*cgroup_dir), SIGTERM);
+        return;
+    }
+
+    signalProcesses(::getSnapshot().getRelatedPids(pid), SIGTERM);
+}
+
+void NativeProcessHandler::terminate(uint pid) const
+{
+    if (const auto cgroup_dir{getDedicatedCgroupDir(pid)})
     {
-        if (kill(static_cast<pid_t>(related_pid), SIGTERM) < 0)
+        qCDebug(lc::os) << "Terminating all processes in" << *cgroup_dir;
+
+        // Kills the whole group atomically, so nothing can fork its way out (requires Linux 5.14)
+        QFile kill_file{*cgroup_dir + "/cgroup.kill"};
+        if (kill_file.open(QIODevice::WriteOnly | QIODevice::Unbuffered) && kill_file.write("1") == 1)
         {
-            const auto error{errno};
-            if (error != ESRCH)
-            {
-                qWarning(lc::os) << "Failed to close process" << related_pid << "-" << lc::getErrorString(error);
-            }
+            return;
         }
+
+        signalProcesses(getCgroupPids(*cgroup_dir), SIGKILL);
+        return;
     }
+
+    signalProcesses(::getSnapshot().getRelatedPids(pid), SIGKILL);
 }
 
-void NativeProcessHandler::terminate(uint pid) const
+int NativeProcessHandler::startProcessEvents()
+{
+    if (m_event_fd < 0)
+    {
+        m_event_fd = openProcConnector();
+    }
+    return m_event_fd;
+}
+
+void NativeProcessHandler::stopProcessEvents()
+{
+    if (m_event_fd >= 0)
+    {
+        ::close(m_event_fd);
+        m_event_fd = -1;
+    }
+}
+
+std::vector<NativeProcessHandler::ProcessEvent> NativeProcessHandler::readProcessEvents()
 {
-    const auto related_pids{getRelatedPids(pid)};
-    for (const auto related_pid : related_pids)
+    std::vector<ProcessEvent> events;
+    if (m_event_fd < 0)
+    {
+        return events;
+    }
+
+    alignas(nlmsghdr) std::array<char, 8192> buffer{};
+    while (true)
     {
-        if (kill(static_cast<pid_t>(related_pid), SIGKILL) < 0)
+        sockaddr_nl sender{};
+        socklen_t   sender_size{sizeof(sender)};
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        auto length{recvfrom(m_event_fd, buffer.data(), buffer.size(), 0, reinterpret_cast<sockaddr*>(&sender),
+                             &sender_size)};
+        if (length < 0)
         {
             const auto error{errno};
-            if (error != ESRCH)
+            if (error == EAGAIN || error == EINTR)
             {
-                qWarning(lc::os) << "Failed to terminate process" << related_pid << "-" << lc::getErrorString(error);
+                break;
+            }
+
+            if (error == ENOBUFS)
+            {
+                // The socket buffer overflowed, but we can keep reading the events that follow
+                events.push_back({.m_type = ProcessEvent::Type::EventsLost});
+                continue;
+            }
+
+            qCWarning(lc::os) << "Failed to read process events -" << lc::getErrorString(error);
+            stopProcessEvents();
+            events.push_back({.m_type = ProcessEvent::Type::EventsLost});
+            break;
+        }
+
+        // Only the kernel is allowed to send these
+        if (sender.nl_pid != 0)
+        {
+            continue;
+        }
+
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        for (auto* header{reinterpret_cast<nlmsghdr*>(buffer.data())}; NLMSG_OK(header, length);
+             header = NLMSG_NEXT(header, length))
+        {
+            if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_OVERRUN)
+            {
+                events.push_back({.m_type = ProcessEvent::Type::EventsLost});
+                continue;
+            }
+
+            const auto* message{static_cast<const cn_msg*>(NLMSG_DATA(header))};
+            if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC)
+            {
+                continue;
+            }
+
+            // NOLINTNEXTLINE(*-reinterpret-cast)
+            const auto* event{reinterpret_cast<const proc_event*>(message->data)};
+            switch (event->what)
+            {
+                case proc_event::PROC_EVENT_EXEC:
+                    events.push_back({.m_type = ProcessEvent::Type::Started,
+                                      .m_pid  = static_cast<uint>(event->event_data.exec.process_tgid)});
+                    break;
+                case proc_event::PROC_EVENT_EXIT:
+                    // Threads exit too, we only care about the whole process
+                    if (event->event_data.exit.process_pid == event->event_data.exit.process_tgid)
+                    {
+                        events.push_back({.m_type = ProcessEvent::Type::Exited,
+                                          .m_pid  = static_cast<uint>(event->event_data.exit.process_tgid)});
+                    }
+                    break;
+                default:
+                    break;
             }
         }
     }
+
+    return events;
 }
 }  // namespace os
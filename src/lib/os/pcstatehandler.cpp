@@ -86,24 +86,33 @@ bool PcStateHandler::doChangeState(uint grace_period_in_sec, const QString& cant
                        [this, failed_to_do_entry, do_method]()
                        {
                            qCInfo(lc::os) << "Setting PC state to transient.";
-                           m_state = enums::PcState::Transient;
+                           setState(enums::PcState::Transient);
 
                            constexpr int state_reset_time{5};
                            QTimer::singleShot(getTimeoutTime(state_reset_time), this,
                                               [this]()
                                               {
                                                   qCInfo(lc::os) << "Resetting PC state back to normal.";
-                                                  m_state = enums::PcState::Normal;
+                                                  setState(enums::PcState::Normal);
                                               });
 
                            if (!(m_native_handler.get()->*do_method)())
                            {
                                qCWarning(lc::os).nospace() << "Failed to " << failed_to_do_entry << " PC!";
-                               m_state = enums::PcState::Normal;
+                               setState(enums::PcState::Normal);
                            }
                        });
 
-    m_state = new_state;
+    setState(new_state);
     return true;
 }
+
+void PcStateHandler::setState(const enums::PcState state)
+{
+    if (m_state != state)
+    {
+        m_state = state;
+        emit signalPcStateChanged();
+    }
+}
 }  // namespace os
@@ -0,0 +1,111 @@
+// header file include
+#include "os/processexitwatcher.h"
+
+// system/Qt includes
+#include <QSocketNotifier>
+#if defined(Q_OS_LINUX)
+    #include <cerrno>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+// local includes
+#include "common/loggingcategories.h"
+
+namespace
+{
+#if defined(Q_OS_LINUX)
+int openPidFd(const uint pid)
+{
+    #if defined(SYS_pidfd_open)
+    return static_cast<int>(syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+    #else
+    errno = ENOSYS;
+    return -1;
+    #endif
+}
+#endif
+}  // namespace
+
+namespace os
+{
+ProcessExitWatcher::~ProcessExitWatcher()
+{
+    while (!m_watches.empty())
+    {
+        unwatch(m_watches.begin()->first);
+    }
+}
+
+ProcessExitWatcher::WatchResult ProcessExitWatcher::watch(const uint pid)
+{
+    if (isWatching(pid))
+    {
+        return WatchResult::Watching;
+    }
+
+#if defined(Q_OS_LINUX)
+    const int fd{openPidFd(pid)};
+    if (fd < 0)
+    {
+        const auto error{errno};
+        if (error == ESRCH)
+        {
+            return WatchResult::NotRunning;
+        }
+
+        qCDebug(lc::os) << "cannot watch process" << pid << "for exit -" << lc::getErrorString(error);
+        return WatchResult::Unsupported;
+    }
+
+    // The pidfd becomes readable once the process terminates
+    auto* notifier{new QSocketNotifier(fd, QSocketNotifier::Read, this)};
+    connect(notifier, &QSocketNotifier::activated, this,
+            [this, pid]()
+            {
+                unwatch(pid);
+                emit signalProcessExited(pid);
+            });
+
+    m_watches[pid] = {.m_fd = fd, .m_notifier = notifier};
+    return WatchResult::Watching;
+#else
+    Q_UNUSED(pid);
+    return WatchResult::Unsupported;
+#endif
+}
+
+void ProcessExitWatcher::unwatch(const uint pid)
+{
+    auto it{m_watches.find(pid)};
+    if (it == std::end(m_watches))
+    {
+        return;
+    }
+
+    // The notifier might be the one currently emitting, so it cannot be deleted right away
+    it->second.m_notifier->setEnabled(false);
+    it->second.m_notifier->deleteLater();
+#if defined(Q_OS_LINUX)
+    ::close(it->second.m_fd);
+#endif
+
+    m_watches.erase(it);
+}
+
+bool ProcessExitWatcher::isWatching(const uint pid) const
+{
+    return m_watches.contains(pid);
+}
+
+std::vector<uint> ProcessExitWatcher::getPids() const
+{
+    std::vector<uint> pids;
+    pids.reserve(m_watches.size());
+    for (const auto& [pid, watch] : m_watches)
+    {
+        pids.push_back(pid);
+    }
+    return pids;
+}
+}  // namespace os
@@ -2,6 +2,7 @@
 #include "os/processhandler.h"
 
 // system/Qt includes
+#include <QSocketNotifier>
 
 // os-specific includes
 #if defined(Q_OS_WIN)
@@ -29,6 +30,16 @@ std::vector<uint> ProcessHandler::getPids() const
     return m_native_handler->getPids();
 }
 
+ProcessSnapshot ProcessHandler::getSnapshot() const
+{
+    return m_native_handler->getSnapshot();
+}
+
+QString ProcessHandler::getName(uint pid) const
+{
+    return m_native_handler->getName(pid);
+}
+
 QString ProcessHandler::getExecPath(uint pid) const
 {
     return m_native_handler->getExecPath(pid);
@@ -48,4 +59,69 @@ void ProcessHandler::terminate(uint pid) const
 {
     return m_native_handler->terminate(pid);
 }
+
+bool ProcessHandler::startMonitoring()
+{
+    if (isMonitoring())
+    {
+        return true;
+    }
+
+    const int fd{m_native_handler->startProcessEvents()};
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    m_event_notifier = std::make_unique<QSocketNotifier>(fd, QSocketNotifier::Read);
+    connect(m_event_notifier.get(), &QSocketNotifier::activated, this, &ProcessHandler::slotHandleProcessEvents);
+
+    qCDebug(lc::os) << "Started monitoring process events.";
+    return true;
+}
+
+void ProcessHandler::stopMonitoring()
+{
+    m_event_notifier.reset();
+    m_native_handler->stopProcessEvents();
+}
+
+bool ProcessHandler::isMonitoring() const
+{
+    return m_event_notifier != nullptr;
+}
+
+void ProcessHandler::slotHandleProcessEvents()
+{
+    using Type = NativeProcessHandlerInterface::ProcessEvent::Type;
+
+    bool events_lost{false};
+    for (const auto& event : m_native_handler->readProcessEvents())
+    {
+        switch (event.m_type)
+        {
+            case Type::Started:
+                emit signalProcessStarted(event.m_pid);
+                break;
+            case Type::Exited:
+                emit signalProcessExited(event.m_pid);
+                break;
+            case Type::EventsLost:
+                events_lost = true;
+                break;
+        }
+    }
+
+    if (events_lost)
+    {
+        // The native handler drops the source if it can no longer be read from
+        if (m_native_handler->startProcessEvents() != m_event_notifier->socket())
+        {
+            qCWarning(lc::os) << "Lost the process event source.";
+            stopMonitoring();
+        }
+
+        emit signalProcessEventsLost();
+    }
+}
 }  // namespace os
@@ -5,8 +5,10 @@
 #include <windows.h>
 
 // system/Qt includes
+#include <QFileInfo>
 #include <QTimeZone>
 #include <psapi.h>
+#include <tlhelp32.h>
 
 // local includes
 #include "common/loggingcategories.h"
@@ -32,6 +34,8 @@ auto useProcHandle(const uint pid, Getter&& getter)
 
 namespace os
 {
+NativeProcessHandler::~NativeProcessHandler() = default;
+
 std::vector<uint> NativeProcessHandler::getPids() const
 {
     std::vector<DWORD> handles;
@@ -67,6 +71,41 @@ std::vector<uint> NativeProcessHandler::getPids() const
     return {};
 }
 
+ProcessSnapshot NativeProcessHandler::getSnapshot() const
+{
+    HANDLE snapshot_handle = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot_handle == INVALID_HANDLE_VALUE)
+    {
+        qCWarning(lc::os) << "Failed to take a process snapshot! Reason:" << lc::getErrorString(GetLastError());
+        return ProcessSnapshot{};
+    }
+
+    auto cleanup = qScopeGuard([&]() { CloseHandle(snapshot_handle); });
+
+    std::vector<ProcessSnapshot::Entry> entries;
+    PROCESSENTRY32W                     entry{};
+    entry.dwSize = sizeof(entry);
+
+    for (BOOL result = Process32FirstW(snapshot_handle, &entry); result == TRUE;
+         result      = Process32NextW(snapshot_handle, &entry))
+    {
+        const auto pid{static_cast<uint>(entry.th32ProcessID)};
+        entries.push_back({.m_pid        = pid,
+                           .m_parent_pid = static_cast<uint>(entry.th32ParentProcessID),
+                           .m_start_time = getStartTime(pid),
+                           // NOLINTNEXTLINE(*-array-to-pointer-decay, *-no-array-decay)
+                           .m_name       = QString::fromWCharArray(entry.szExeFile)});
+    }
+
+    return ProcessSnapshot{std::move(entries)};
+}
+
+QString NativeProcessHandler::getName(uint pid) const
+{
+    // Same as the executable name in the snapshot
+    return QFileInfo{getExecPath(pid)}.fileName();
+}
+
 QString NativeProcessHandler::getExecPath(uint pid) const
 {
     return useProcHandle(
@@ -203,4 +242,21 @@ void NativeProcessHandler::terminate(uint pid) const
                                     << ")! Reason: " << lc::getErrorString(GetLastError());
     }
 }
+
+// NOLINTNEXTLINE(*-static)
+int NativeProcessHandler::startProcessEvents()
+{
+    // Not implemented, the process list has to be polled
+    return -1;
+}
+
+void NativeProcessHandler::stopProcessEvents()
+{
+}
+
+// NOLINTNEXTLINE(*-static)
+std::vector<NativeProcessHandler::ProcessEvent> NativeProcessHandler::readProcessEvents()
+{
+    return {};
+}
 }  // namespace os
@@ -16,6 +16,7 @@ void ClientIds::load()
 {
     m_ids = json::tryPartialReadFromFile<std::set<QString>>(m_filepath);
     m_ids.erase(QString{});
+    rebuildAuthTokens();
 }
 
 void ClientIds::save() const
@@ -29,13 +30,34 @@ bool ClientIds::containsId(const QString& client_id) const
     return m_ids.contains(client_id);
 }
 
+bool ClientIds::containsAuthToken(const QByteArray& token) const
+{
+    return m_auth_tokens.contains(token);
+}
+
 void ClientIds::addId(const QString& client_id)
 {
-    m_ids.emplace(client_id);
+    if (m_ids.emplace(client_id).second)
+    {
+        rebuildAuthTokens();
+    }
 }
 
 void ClientIds::removeId(const QString& client_id)
 {
-    m_ids.erase(client_id);
+    if (m_ids.erase(client_id) > 0)
+    {
+        rebuildAuthTokens();
+    }
+}
+
+void ClientIds::rebuildAuthTokens()
+{
+    // Tokens are kept in the same encoding as they arrive in the "Authorization" header
+    m_auth_tokens.clear();
+    for (const auto& client_id : m_ids)
+    {
+        m_auth_tokens.insert(client_id.toUtf8().toBase64());
+    }
 }
 }  // namespace server
\ No newline at end of file
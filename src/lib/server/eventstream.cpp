@@ -0,0 +1,124 @@
+// header file include
+#include "server/eventstream.h"
+
+// local includes
+#include "common/loggingcategories.h"
+
+namespace
+{
+constexpr std::chrono::seconds HEARTBEAT_INTERVAL{30};
+constexpr std::size_t          MAX_SUBSCRIBERS{8};
+
+QByteArray toChunk(const server::EventStream::Event& event)
+{
+    return "event: " + event.m_name + "\ndata: " + event.m_data + "\n\n";
+}
+}  // namespace
+
+namespace server
+{
+std::chrono::seconds EventStream::getHeartbeatInterval()
+{
+    return HEARTBEAT_INTERVAL;
+}
+
+EventStream::EventStream()
+{
+    connect(&m_heartbeat_timer, &QTimer::timeout, this, &EventStream::slotSendHeartbeat);
+    m_heartbeat_timer.setInterval(HEARTBEAT_INTERVAL);
+}
+
+EventStream::~EventStream()
+{
+    for (const auto& subscriber : m_subscribers)
+    {
+        subscriber.m_responder->writeEndChunked({});
+    }
+}
+
+void EventStream::subscribe(QHttpServerResponder&& responder, QAbstractSocket* connection,
+                            const QList<Event>& initial_events)
+{
+    // Still a hard limit, in case the connections of the clients are unknown or are kept alive for too long
+    if (m_subscribers.size() >= MAX_SUBSCRIBERS)
+    {
+        qCDebug(lc::server) << "Too many event stream subscribers, dropping the oldest one.";
+        QObject::disconnect(m_subscribers.front().m_disconnected_connection);
+        m_subscribers.front().m_responder->writeEndChunked({});
+        m_subscribers.pop_front();
+    }
+
+    QHttpHeaders headers;
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType, "text/event-stream");
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "no-cache");
+
+    auto subscriber{std::make_unique<QHttpServerResponder>(std::move(responder))};
+    subscriber->writeBeginChunked(headers);
+    for (const auto& event : initial_events)
+    {
+        subscriber->writeChunk(toChunk(event));
+    }
+
+    QMetaObject::Connection disconnected_connection;
+    if (connection)
+    {
+        disconnected_connection = connect(connection, &QAbstractSocket::disconnected, this,
+                                          [this, responder_ptr = subscriber.get()]()
+                                          { removeSubscriber(responder_ptr); });
+    }
+
+    m_subscribers.push_back({.m_responder               = std::move(subscriber),
+                             .m_disconnected_connection = std::move(disconnected_connection)});
+    if (!m_heartbeat_timer.isActive())
+    {
+        m_heartbeat_timer.start();
+    }
+
+    qCDebug(lc::server) << "New event stream subscriber. Total subscribers:" << m_subscribers.size();
+}
+
+void EventStream::publish(const Event& event)
+{
+    if (m_subscribers.empty())
+    {
+        return;
+    }
+
+    const auto chunk{toChunk(event)};
+    for (const auto& subscriber : m_subscribers)
+    {
+        subscriber.m_responder->writeChunk(chunk);
+    }
+}
+
+std::size_t EventStream::getSubscriberCount() const
+{
+    return m_subscribers.size();
+}
+
+void EventStream::slotSendHeartbeat()
+{
+    if (m_subscribers.empty())
+    {
+        m_heartbeat_timer.stop();
+        return;
+    }
+
+    // Keeps the connection from being closed as idle and lets the clients notice a dead connection
+    for (const auto& subscriber : m_subscribers)
+    {
+        subscriber.m_responder->writeChunk(": heartbeat\n\n");
+    }
+}
+
+void EventStream::removeSubscriber(const QHttpServerResponder* responder)
+{
+    // The connection is already gone, so there is nothing left to write to
+    const auto removed{std::erase_if(m_subscribers, [responder](const auto& subscriber)
+                                     { return subscriber.m_responder.get() == responder; })};
+    if (removed > 0)
+    {
+        qCDebug(lc::server) << "Event stream subscriber has disconnected. Total subscribers:" << m_subscribers.size();
+    }
+}
+}  // namespace server
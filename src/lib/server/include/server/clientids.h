@@ -1,6 +1,7 @@
 #pragma once
 
 // system/Qt includes
+#include <QSet>
 #include <QString>
 #include <set>
 
@@ -18,11 +19,15 @@ public:
     void save() const;
 
     bool containsId(const QString& client_id) const;
+    bool containsAuthToken(const QByteArray& token) const;
     void addId(const QString& client_id);
     void removeId(const QString& client_id);
 
 private:
+    void rebuildAuthTokens();
+
     QString           m_filepath;
     std::set<QString> m_ids;
+    QSet<QByteArray>  m_auth_tokens;
 };
 }  // namespace server
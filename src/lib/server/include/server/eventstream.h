@@ -0,0 +1,50 @@
+#pragma once
+
+// system/Qt includes
+#include <QAbstractSocket>
+#include <QTimer>
+#include <QtHttpServer/QHttpServerResponder>
+#include <deque>
+#include <memory>
+
+namespace server
+{
+class EventStream : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(EventStream)
+
+public:
+    struct Event
+    {
+        QByteArray m_name;
+        QByteArray m_data;
+    };
+
+    static std::chrono::seconds getHeartbeatInterval();
+
+    explicit EventStream();
+    ~EventStream() override;
+
+    // The subscriber is dropped as soon as the connection goes away (if it is known)
+    void subscribe(QHttpServerResponder&& responder, QAbstractSocket* connection, const QList<Event>& initial_events);
+    void publish(const Event& event);
+
+    std::size_t getSubscriberCount() const;
+
+private slots:
+    void slotSendHeartbeat();
+
+private:
+    struct Subscriber
+    {
+        std::unique_ptr<QHttpServerResponder> m_responder;
+        QMetaObject::Connection               m_disconnected_connection;
+    };
+
+    void removeSubscriber(const QHttpServerResponder* responder);
+
+    std::deque<Subscriber> m_subscribers;
+    QTimer                 m_heartbeat_timer;
+};
+}  // namespace server
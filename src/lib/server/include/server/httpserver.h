@@ -1,6 +1,8 @@
 #pragma once
 
 // system/Qt includes
+#include <QAbstractSocket>
+#include <QPointer>
 #include <QtHttpServer/QHttpServer>
 
 // forward declaration
@@ -16,16 +18,25 @@ class HttpServer
     Q_DISABLE_COPY(HttpServer)
 
 public:
+    enum class AuthPolicy
+    {
+        None,
+        ClientId
+    };
+
     static QString getAuthorizationId(const QHttpServerRequest& request);
 
     explicit HttpServer(int api_version, ClientIds& client_ids);
     virtual ~HttpServer() = default;
 
     bool startServer(quint16 port, const QString& ssl_cert_file, const QString& ssl_key_file,
-                     QSsl::SslProtocol protocol);
+                     QSsl::SslProtocol protocol, std::chrono::seconds idle_timeout);
 
     int  getApiVersion() const;
     bool isAuthorized(const QHttpServerRequest& request) const;
+    bool authorize(const QHttpServerRequest& request, AuthPolicy policy);
+
+    QAbstractSocket* getConnection(const QHttpServerRequest& request) const;
 
     template<typename Functor>
     bool route(const QString& path_pattern, QHttpServerRequest::Methods method, Functor&& functor);
@@ -34,9 +45,13 @@ public:
     void afterRequest(ViewHandler&& view_handler);
 
 private:
-    int         m_api_version;
-    ClientIds&  m_client_ids;
-    QHttpServer m_server;
+    using ConnectionKey = std::pair<QHostAddress, quint16>;
+
+    int                                             m_api_version;
+    ClientIds&                                      m_client_ids;
+    quint64                                         m_rejected_requests{0};
+    QHash<ConnectionKey, QPointer<QAbstractSocket>> m_connections;  // Must outlive the server
+    QHttpServer                                     m_server;
 };
 
 template<typename Functor>
@@ -1,6 +1,7 @@
 #pragma once
 
 // system/Qt includes
+#include <QDateTime>
 #include <filesystem>
 
 // local includes
@@ -9,12 +10,19 @@
 
 namespace steam
 {
-// This is a very "son, we have a parser at home" kind of parser, very basic, but gets the job done...
+// Non-Steam shortcut, as stored in the binary VDF file of the user
 struct ShortcutsVdfEntry
 {
-    AppId   m_app_id;
-    QString m_app_name;
-    QString m_start_dir;
+    AppId                m_app_id;
+    QString              m_app_name;
+    QString              m_start_dir;
+    QString              m_exe;
+    QString              m_launch_options;
+    QString              m_icon;
+    std::vector<QString> m_tags;
+    QDateTime            m_last_play_time;
+
+    static std::filesystem::path getShortcutsVdfPath(const std::filesystem::path& steam_dir, const SteamId& user_id);
 
     static std::optional<std::vector<ShortcutsVdfEntry>> scrapeShortcutsVdf(const QByteArray& contents);
     static std::optional<std::vector<ShortcutsVdfEntry>> scrapeShortcutsVdf(const std::filesystem::path& steam_dir,
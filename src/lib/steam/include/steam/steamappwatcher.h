@@ -20,8 +20,13 @@ public:
     enums::AppState getAppState() const;
     const AppId&    getAppId() const;
 
+signals:
+    void signalAppStateChanged();
+
 private slots:
     void slotCheckState();
+    void slotCheckAppState(const steam::AppId& app_id);
+    void slotProcessStateChanged();
 
 private:
     struct TrackingMetadata
@@ -37,11 +42,13 @@ private:
     static enums::AppState getAppState(const SteamProcessTracker::LogTrackers& log_trackers,
                                        const TrackingMetadata& metadata, enums::AppState prev_state);
 
-    const SteamProcessTracker&      m_process_tracker;
-    AppId                           m_app_id;
-    std::optional<TrackingMetadata> m_metadata;
+    void connectToLogTrackers();
+
+    const SteamProcessTracker&              m_process_tracker;
+    AppId                                   m_app_id;
+    std::optional<TrackingMetadata>         m_metadata;
+    const SteamProcessTracker::LogTrackers* m_connected_log_trackers{nullptr};
 
     enums::AppState m_current_state{enums::AppState::Stopped};
-    QTimer          m_check_timer;
 };
 }  // namespace steam
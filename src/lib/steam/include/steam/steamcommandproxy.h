@@ -1,5 +1,10 @@
 #pragma once
 
+// system/Qt includes
+#include <QFileSystemWatcher>
+#include <QProcess>
+#include <QTimer>
+
 // local includes
 #include "appid.h"
 
@@ -11,13 +16,14 @@ struct AppSettings;
 
 namespace steam
 {
-class SteamCommandProxy final
+class SteamCommandProxy : public QObject
 {
+    Q_OBJECT
     Q_DISABLE_COPY(SteamCommandProxy)
 
 public:
     explicit SteamCommandProxy(const common::AppSettings& app_settings);
-    ~SteamCommandProxy() = default;
+    ~SteamCommandProxy() override;
 
     bool canExecuteCommands() const;
 
@@ -27,7 +33,25 @@ public:
     bool close();
     bool closeBigPictureMode();
 
+private slots:
+    void slotResolveSteamExecutable();
+    void slotHandleFlatpakCheckFinished(int exit_code, QProcess::ExitStatus exit_status);
+    void slotHandleFlatpakCheckError(QProcess::ProcessError error);
+    void slotHandleFlatpakCheckTimeout();
+
 private:
+    QStringList getSteamExecutableWithArgs() const;
+    QString     getSteamPipePath() const;
+    bool        executeSteamCommand(const QStringList& steam_args, const QMap<QString, QString>& env_overrides = {});
+    void        setResolvedSteamExecutable(const QStringList& exec_with_args);
+    void        stopFlatpakCheck();
+    void        watchExecutableLocations();
+
     const common::AppSettings& m_app_settings;
+    QStringList                m_resolved_steam_exec;
+    QFileSystemWatcher         m_exec_location_watcher;
+    QTimer                     m_resolve_timer;
+    std::unique_ptr<QProcess>  m_flatpak_check;
+    QTimer                     m_flatpak_check_timer;
 };
 }  // namespace steam
@@ -19,8 +19,13 @@ public:
 
     const std::optional<SteamId>& getCurrentSteamId() const;
 
+signals:
+    void signalSteamIdChanged();
+
 protected:
-    void onLogChanged(const std::vector<QString>& new_lines) override;
+    void    onLogChanged(const std::vector<QByteArrayView>& new_lines) override;
+    QString saveState() const override;
+    bool    restoreState(const QString& state) override;
 
 private:
     std::optional<SteamId> m_current_steam_id;
@@ -43,8 +43,13 @@ public:
 
     AppState getAppState(const AppId& app_id) const;
 
+signals:
+    void signalAppStateChanged(const steam::AppId& app_id, AppState state);
+
 protected:
-    void onLogChanged(const std::vector<QString>& new_lines) override;
+    void    onLogChanged(const std::vector<QByteArrayView>& new_lines) override;
+    QString saveState() const override;
+    bool    restoreState(const QString& state) override;
 
 private:
     std::map<AppId, AppState> m_app_states;
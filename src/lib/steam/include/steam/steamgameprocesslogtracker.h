@@ -2,6 +2,7 @@
 
 // local includes
 #include "appid.h"
+#include "os/processexitwatcher.h"
 #include "steamlogtracker.h"
 
 namespace steam
@@ -16,10 +17,22 @@ public:
 
     bool isAnyProcessRunning(const AppId& app_id) const;
 
+signals:
+    void signalRunningProcessesChanged(const steam::AppId& app_id, bool any_running);
+
 protected:
-    void onLogChanged(const std::vector<QString>& new_lines) override;
+    void    onLogChanged(const std::vector<QByteArrayView>& new_lines) override;
+    QString saveState() const override;
+    bool    restoreState(const QString& state) override;
+
+private slots:
+    void slotHandleProcessExited(uint pid);
 
 private:
+    void updateExitWatches();
+    void removePid(uint pid);
+
     std::map<AppId, QSet<uint>> m_app_id_to_process_ids;
+    os::ProcessExitWatcher      m_exit_watcher;
 };
 }  // namespace steam
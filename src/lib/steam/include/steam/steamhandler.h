@@ -33,10 +33,14 @@ public:
     void clearSessionData();
 
     std::optional<std::map<AppId, QString>> getNonSteamAppData(const SteamId& user_id) const;
+    std::optional<std::filesystem::path>    getNonSteamAppDataPath(const SteamId& user_id) const;
     std::optional<SteamId>                  getCurrentUserId() const;
 
 signals:
     void signalSteamClosed();
+    void signalSteamUiModeChanged();
+    void signalAppDataChanged();
+    void signalCurrentUserChanged();
 
 private slots:
     void slotSteamProcessStateChanged();
@@ -47,8 +51,13 @@ private:
         std::unique_ptr<SteamAppWatcher> m_steam_app_watcher;
     };
 
-    SteamCommandProxy   m_command_proxy;
-    SteamProcessTracker m_steam_process_tracker;
-    SessionData         m_session_data;
+    void connectToLogTrackers();
+    void resetSessionData();
+
+    std::chrono::seconds                    m_close_steam_deadline;
+    SteamCommandProxy                       m_command_proxy;
+    SteamProcessTracker                     m_steam_process_tracker;
+    SessionData                             m_session_data;
+    const SteamProcessTracker::LogTrackers* m_connected_log_trackers{nullptr};
 };
 }  // namespace steam
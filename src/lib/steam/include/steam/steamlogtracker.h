@@ -1,10 +1,17 @@
 #pragma once
 
 // system/Qt includes
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QByteArrayView>
 #include <QDateTime>
-#include <QFileSystemWatcher>
+#include <QRegularExpression>
 #include <QTimer>
 #include <filesystem>
+#include <optional>
+
+// forward declarations
+class QFile;
 
 namespace steam
 {
@@ -19,25 +26,80 @@ public:
     };
     Q_ENUM(TimeFormat)
 
+    struct LatencyStats
+    {
+        qint64  m_last_ms{0};
+        qint64  m_max_ms{0};
+        qint64  m_total_ms{0};
+        quint64 m_samples{0};
+    };
+
+    struct ParsingStats
+    {
+        quint64 m_lines_scanned{0};
+        quint64 m_candidate_lines{0};
+        quint64 m_lines_matched{0};
+        qint64  m_time_spent_ns{0};
+    };
+
+    class LinePattern
+    {
+    public:
+        // The (JIT optimized) regex is only run for lines that contain at least one of the anchors (or for every line
+        // if there are none). Every line matched by the regex must contain one of them.
+        explicit LinePattern(const std::vector<QByteArray>& anchors, const QString& pattern);
+
+        bool                      hasAnchor(QByteArrayView line) const;
+        const QRegularExpression& getRegex() const;
+
+    private:
+        std::vector<QByteArrayMatcher> m_anchors;
+        QRegularExpression             m_regex;
+    };
+
     explicit SteamLogTracker(std::filesystem::path main_filename, std::filesystem::path backup_filename,
                              QDateTime  first_entry_time_filter,
                              TimeFormat time_format = TimeFormat::YYYY_MM_DD_hh_mm_ss);
-    ~SteamLogTracker() override = default;
+    ~SteamLogTracker() override;
+
+    const std::filesystem::path& getMainFilename() const;
+    const std::filesystem::path& getBackupFilename() const;
+    const LatencyStats&          getLatencyStats() const;
+    const ParsingStats&          getParsingStats() const;
 
-public slots:
-    void slotCheckLog();
+    void setCheckpointFile(std::filesystem::path filepath);
+    void saveCheckpoint();
+
+    bool checkLog();
 
 protected:
-    virtual void onLogChanged(const std::vector<QString>& new_lines) = 0;
+    // The views are only valid for the duration of the call.
+    virtual void onLogChanged(const std::vector<QByteArrayView>& new_lines) = 0;
+
+    // Derived state that is stored together with the read position, so that the logs don't have to be re-read.
+    virtual QString saveState() const                  = 0;
+    virtual bool    restoreState(const QString& state) = 0;
+
+    QRegularExpressionMatch matchLine(const LinePattern& pattern, QByteArrayView line);
 
 private:
-    std::filesystem::path m_main_filename;
-    std::filesystem::path m_backup_filename;
-    QDateTime             m_first_entry_time_filter;
-    TimeFormat            m_time_format;
-    QFileSystemWatcher    m_file_watcher;
-    qint64                m_last_prev_size{0};
-    qint64                m_last_read_pos{0};
-    bool                  m_initialized{false};
+    bool   tryRestoreCheckpoint(QFile& main_file);
+    qint64 readLines(QFile& file, qint64 offset, bool include_incomplete_line);
+    void   updateLatencyStats(const QFile& file);
+
+    std::filesystem::path       m_main_filename;
+    std::filesystem::path       m_backup_filename;
+    std::optional<qint64>       m_session_time_key;
+    std::optional<qint64>       m_first_entry_time_filter;
+    TimeFormat                  m_time_format;
+    qint64                      m_last_prev_size{0};
+    qint64                      m_last_read_pos{0};
+    bool                        m_initialized{false};
+    LatencyStats                m_latency_stats;
+    ParsingStats                m_parsing_stats;
+    QByteArray                  m_read_buffer;
+    std::vector<QByteArrayView> m_lines;
+    std::filesystem::path       m_checkpoint_file;
+    QTimer                      m_checkpoint_timer;
 };
 }  // namespace steam
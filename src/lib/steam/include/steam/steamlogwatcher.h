@@ -0,0 +1,51 @@
+#pragma once
+
+// system/Qt includes
+#include <QFileSystemWatcher>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <filesystem>
+#include <memory>
+
+// forward declarations
+namespace steam
+{
+class SteamLogTracker;
+}
+
+namespace steam
+{
+class SteamLogWatcher : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(SteamLogWatcher)
+
+public:
+    explicit SteamLogWatcher(std::filesystem::path logs_dir);
+    ~SteamLogWatcher() override;
+
+    void addTracker(SteamLogTracker& tracker);
+    bool isUsingNativeEvents() const;
+
+public slots:
+    void slotCheckAllLogs();
+
+private slots:
+    void slotHandleNativeEvents();
+    void slotHandleFileChanged(const QString& path);
+    void slotPoll();
+
+private:
+    bool tryStartNativeWatch();
+    void stopNativeWatch();
+    void startPolling();
+    static bool checkLogs(const std::vector<SteamLogTracker*>& trackers);
+
+    std::filesystem::path            m_logs_dir;
+    std::vector<SteamLogTracker*>    m_trackers;
+    int                              m_native_fd{-1};
+    std::unique_ptr<QSocketNotifier> m_native_notifier;
+    QFileSystemWatcher               m_file_watcher;
+    QTimer                           m_poll_timer;
+};
+}  // namespace steam
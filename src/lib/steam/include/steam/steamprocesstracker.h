@@ -1,13 +1,17 @@
 #pragma once
 
 // system/Qt includes
+#include <QElapsedTimer>
+#include <chrono>
 #include <filesystem>
 
 // local includes
+#include "os/processexitwatcher.h"
 #include "os/processhandler.h"
 #include "steamconnectionlogtracker.h"
 #include "steamcontentlogtracker.h"
 #include "steamgameprocesslogtracker.h"
+#include "steamlogwatcher.h"
 #include "steamshaderlogtracker.h"
 #include "steamwebhelperlogtracker.h"
 
@@ -21,18 +25,19 @@ class SteamProcessTracker : public QObject
 public:
     struct LogTrackers
     {
-        QTimer                     m_read_timer;
         SteamWebHelperLogTracker   m_web_helper;
         SteamContentLogTracker     m_content_log;
         SteamGameProcessLogTracker m_gameprocess_log;
         SteamShaderLogTracker      m_shader_log;
         SteamConnectionLogTracker  m_connection_log;
+        SteamLogWatcher            m_log_watcher;  // Must be destroyed before the trackers
     };
 
-    explicit SteamProcessTracker();
+    explicit SteamProcessTracker(std::filesystem::path checkpoint_dir);
     ~SteamProcessTracker() override;
 
-    void close();
+    void close(std::chrono::seconds deadline);
+    void startShutdownDeadline(std::chrono::seconds deadline);
 
     bool                  isRunning() const;
     uint                  getPid() const;
@@ -47,7 +52,9 @@ public slots:
     void slotCheckState();
 
 private slots:
-    void slotCheckLogs();
+    void slotHandleProcessStarted(uint pid);
+    void slotHandleProcessExited(uint pid);
+    void slotShutdownDeadlineReached();
 
 private:
     struct ProcessData
@@ -58,9 +65,26 @@ private:
         std::filesystem::path        m_steam_dir;
     };
 
-    ProcessData m_data;
-    QTimer      m_check_timer;
+    struct NonSteamProcess
+    {
+        QDateTime m_start_time;
+        QString   m_name;  // Empty if the verdict applies regardless of the name
+    };
+
+    bool tryTrackProcess(uint pid, const QDateTime& start_time, const QString& name = {});
+    void clearProcessData();
+
+    std::filesystem::path           m_checkpoint_dir;
+    ProcessData                     m_data;
+    QTimer                          m_check_timer;
+    QTimer                          m_shutdown_deadline_timer;
+    QElapsedTimer                   m_shutdown_elapsed;
+    bool                            m_shutdown_escalated{false};
+    bool                            m_has_unresolved_steam{false};  // Steam was found, but its directory is not ready
+    bool                            m_process_events_available{false};
+    std::map<uint, NonSteamProcess> m_non_steam_processes;          // To skip re-matching unchanged processes
 
-    os::ProcessHandler m_process_handler;
+    os::ProcessHandler     m_process_handler;
+    os::ProcessExitWatcher m_exit_watcher;
 };
 }  // namespace steam
@@ -19,8 +19,13 @@ public:
 
     bool isAppCompilingShaders(const AppId& app_id) const;
 
+signals:
+    void signalShaderCompilationChanged(const steam::AppId& app_id, bool compiling);
+
 protected:
-    void onLogChanged(const std::vector<QString>& new_lines) override;
+    void    onLogChanged(const std::vector<QByteArrayView>& new_lines) override;
+    QString saveState() const override;
+    bool    restoreState(const QString& state) override;
 
 private:
     std::set<AppId> m_apps_with_compiling_shaders;
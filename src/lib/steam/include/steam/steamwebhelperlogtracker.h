@@ -16,8 +16,13 @@ public:
 
     enums::SteamUiMode getSteamUiMode() const;
 
+signals:
+    void signalSteamUiModeChanged();
+
 protected:
-    void onLogChanged(const std::vector<QString>& new_lines) override;
+    void    onLogChanged(const std::vector<QByteArrayView>& new_lines) override;
+    QString saveState() const override;
+    bool    restoreState(const QString& state) override;
 
 private:
     enums::SteamUiMode m_ui_mode{enums::SteamUiMode::Unknown};
@@ -4,153 +4,374 @@
 // system/Qt includes
 #include <QDateTime>
 #include <QFileInfo>
+#include <QTimeZone>
+#include <cstring>
 
 // local includes
 #include "common/loggingcategories.h"
 
 namespace
 {
-qsizetype indexOfInsensitive(const QByteArray& data, const QByteArrayView view, qsizetype from)
+// Shortcuts only nest a couple of levels deep, anything more is corrupt (and must not overflow the stack)
+constexpr int MAX_SKIPPED_MAP_DEPTH{32};
+
+// Value types of Valve's binary KeyValues format
+enum class VdfType : std::uint8_t
 {
-    const auto needle{view.at(0)};
-    while (true)
+    Map       = 0x00,
+    String    = 0x01,
+    Int32     = 0x02,
+    Float32   = 0x03,
+    Pointer   = 0x04,
+    Color     = 0x06,
+    UInt64    = 0x07,
+    MapEnd    = 0x08,
+    Int64     = 0x0A,
+    AltMapEnd = 0x0B
+};
+
+class BinaryVdfReader
+{
+public:
+    explicit BinaryVdfReader(const QByteArrayView data)
+        : m_data{data}
     {
-        from = data.indexOf(needle, from);
-        if (from == -1)
+    }
+
+    std::optional<VdfType> readType()
+    {
+        if (m_pos >= m_data.size())
         {
-            break;
+            return std::nullopt;
         }
 
-        if (const char* needle_ptr{data.data() + from};
-            qstrnicmp(needle_ptr, view.data(), qMin(data.size() - from, view.size())) == 0)
+        return static_cast<VdfType>(m_data.at(m_pos++));
+    }
+
+    std::optional<QByteArrayView> readString()
+    {
+        const auto  remaining{m_data.sliced(m_pos)};
+        const auto* terminator{static_cast<const char*>(std::memchr(remaining.data(), '\0', remaining.size()))};
+        if (terminator == nullptr)
         {
-            break;
+            return std::nullopt;
         }
-        ++from;
+
+        const auto value{remaining.first(terminator - remaining.data())};
+        m_pos += value.size() + 1;
+        return value;
     }
 
-    return from;
-}
+    std::optional<std::uint32_t> readUInt32()
+    {
+        if (m_pos + 4 > m_data.size())
+        {
+            return std::nullopt;
+        }
 
-std::optional<std::vector<std::uint32_t>> scrapeAppIds(const QByteArray& contents)
-{
-    std::vector<std::uint32_t> app_ids;
+        const auto* bytes{reinterpret_cast<const std::uint8_t*>(m_data.data() + m_pos)};  // NOLINT(*-reinterpret-cast)
+        m_pos += 4;
+        return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8U
+               | static_cast<std::uint32_t>(bytes[2]) << 16U | static_cast<std::uint32_t>(bytes[3]) << 24U;
+    }
+
+    bool skipValue(const VdfType type)
     {
-        constexpr QByteArrayView app_id_view("\x02"
-                                             "appid"
-                                             "\x00");
-        qsizetype                from{0};
+        switch (type)
+        {
+            case VdfType::String:
+                return readString().has_value();
+            case VdfType::Int32:
+            case VdfType::Float32:
+            case VdfType::Pointer:
+            case VdfType::Color:
+                return skipBytes(4);
+            case VdfType::UInt64:
+            case VdfType::Int64:
+                return skipBytes(8);
+            case VdfType::Map:
+                return skipMap();
+            case VdfType::MapEnd:
+            case VdfType::AltMapEnd:
+                break;
+        }
+
+        return false;
+    }
+
+private:
+    bool skipBytes(const qsizetype count)
+    {
+        if (m_pos + count > m_data.size())
+        {
+            return false;
+        }
+
+        m_pos += count;
+        return true;
+    }
+
+    bool skipMap()
+    {
+        if (m_skipped_map_depth >= MAX_SKIPPED_MAP_DEPTH)
+        {
+            qCWarning(lc::steam) << "Binary VDF maps are nested too deeply, giving up at offset" << m_pos;
+            return false;
+        }
+
+        ++m_skipped_map_depth;
+        const auto restore_depth{qScopeGuard([this]() { --m_skipped_map_depth; })};
         while (true)
         {
-            from = indexOfInsensitive(contents, app_id_view, from);
-            if (from == -1)
+            const auto type{readType()};
+            if (!type)
             {
-                break;
+                return false;
             }
-            from += app_id_view.size() + 1;
 
-            if (from + 4 > contents.size())
+            if (*type == VdfType::MapEnd || *type == VdfType::AltMapEnd)
             {
-                qCWarning(lc::steam) << "Out of range error while scraping shortcuts.vdf for appid!";
-                return std::nullopt;
+                return true;
             }
 
-            const std::uint32_t app_id{
-                static_cast<std::uint32_t>(static_cast<std::uint8_t>(contents.at(from)))
-                | static_cast<std::uint32_t>(static_cast<std::uint8_t>(contents.at(from + 1))) << 8U
-                | static_cast<std::uint32_t>(static_cast<std::uint8_t>(contents.at(from + 2))) << 16U
-                | static_cast<std::uint32_t>(static_cast<std::uint8_t>(contents.at(from + 3))) << 24U};
-            app_ids.emplace_back(app_id);
+            if (!readString() || !skipValue(*type))
+            {
+                return false;
+            }
         }
     }
-    return app_ids;
+
+    QByteArrayView m_data;
+    qsizetype      m_pos{0};
+    int            m_skipped_map_depth{0};
+};
+
+bool isMapEnd(const VdfType type)
+{
+    return type == VdfType::MapEnd || type == VdfType::AltMapEnd;
 }
 
-std::optional<std::vector<QString>> scrapeAppNames(const QByteArray& contents)
+bool keyIs(const QByteArrayView key, const QByteArrayView expected)
 {
-    std::vector<QString> app_names;
+    // Steam has not been consistent with the key casing over the years
+    return key.compare(expected, Qt::CaseInsensitive) == 0;
+}
+
+std::optional<std::vector<QString>> readTags(BinaryVdfReader& reader)
+{
+    std::vector<QString> tags;
+    while (true)
     {
-        constexpr QByteArrayView app_name_view("\x01"
-                                               "appname"
-                                               "\x00");
-        qsizetype                from{0};
-        while (true)
+        const auto type{reader.readType()};
+        if (!type)
         {
-            from = indexOfInsensitive(contents, app_name_view, from);
-            if (from == -1)
-            {
-                break;
-            }
-            from += app_name_view.size() + 1;
+            return std::nullopt;
+        }
 
-            const auto to = contents.indexOf('\0', from);
-            if (to == -1)
+        if (isMapEnd(*type))
+        {
+            return tags;
+        }
+
+        if (!reader.readString())
+        {
+            return std::nullopt;
+        }
+
+        if (*type != VdfType::String)
+        {
+            if (!reader.skipValue(*type))
             {
-                qCWarning(lc::steam) << "Out of range error while scraping shortcuts.vdf for appname!";
                 return std::nullopt;
             }
+            continue;
+        }
 
-            app_names.emplace_back(QString::fromUtf8(contents.data() + from, to - from));
+        const auto tag{reader.readString()};
+        if (!tag)
+        {
+            return std::nullopt;
         }
+
+        tags.emplace_back(QString::fromUtf8(*tag));
     }
-    return app_names;
 }
 
-std::optional<std::vector<QString>> scrapeStartDirs(const QByteArray& contents)
+// Returns std::nullopt on malformed data and an empty inner optional for an entry without an app id
+std::optional<std::optional<steam::ShortcutsVdfEntry>> readEntry(BinaryVdfReader& reader)
 {
-    std::vector<QString> app_names;
+    std::optional<std::uint32_t> app_id;
+    QString                      app_name;
+    QString                      start_dir;
+    QString                      exe;
+    QString                      launch_options;
+    QString                      icon;
+    std::vector<QString>         tags;
+    QDateTime                    last_play_time;
+
+    while (true)
     {
-        constexpr QByteArrayView app_name_view("\x01"
-                                               "startdir"
-                                               "\x00");
-        qsizetype                from{0};
-        while (true)
+        const auto type{reader.readType()};
+        if (!type)
+        {
+            return std::nullopt;
+        }
+
+        if (isMapEnd(*type))
         {
-            from = indexOfInsensitive(contents, app_name_view, from);
-            if (from == -1)
+            break;
+        }
+
+        const auto key{reader.readString()};
+        if (!key)
+        {
+            return std::nullopt;
+        }
+
+        if (*type == VdfType::String)
+        {
+            const auto value{reader.readString()};
+            if (!value)
             {
-                break;
+                return std::nullopt;
+            }
+
+            // Values are only copied for the keys we care about
+            if (keyIs(*key, "appname"))
+            {
+                app_name = QString::fromUtf8(*value);
+            }
+            else if (keyIs(*key, "startdir"))
+            {
+                start_dir = QString::fromUtf8(*value);
+            }
+            else if (keyIs(*key, "exe"))
+            {
+                exe = QString::fromUtf8(*value);
+            }
+            else if (keyIs(*key, "launchoptions"))
+            {
+                launch_options = QString::fromUtf8(*value);
+            }
+            else if (keyIs(*key, "icon"))
+            {
+                icon = QString::fromUtf8(*value);
+            }
+        }
+        else if (*type == VdfType::Int32)
+        {
+            const auto value{reader.readUInt32()};
+            if (!value)
+            {
+                return std::nullopt;
             }
-            from += app_name_view.size() + 1;
 
-            const auto to = contents.indexOf('\0', from);
-            if (to == -1)
+            if (keyIs(*key, "appid"))
+            {
+                app_id = *value;
+            }
+            else if (keyIs(*key, "lastplaytime") && *value != 0)
+            {
+                last_play_time = QDateTime::fromSecsSinceEpoch(*value, QTimeZone::UTC);
+            }
+        }
+        else if (*type == VdfType::Map && keyIs(*key, "tags"))
+        {
+            auto parsed_tags{readTags(reader)};
+            if (!parsed_tags)
             {
-                qCWarning(lc::steam) << "Out of range error while scraping shortcuts.vdf for start dirs!";
                 return std::nullopt;
             }
 
-            app_names.emplace_back(QString::fromUtf8(contents.data() + from, to - from));
+            tags = std::move(*parsed_tags);
+        }
+        else if (!reader.skipValue(*type))
+        {
+            return std::nullopt;
         }
     }
-    return app_names;
+
+    if (!app_id)
+    {
+        return std::optional<steam::ShortcutsVdfEntry>{};
+    }
+
+    return steam::ShortcutsVdfEntry{.m_app_id         = steam::AppId{*app_id},
+                                    .m_app_name       = std::move(app_name),
+                                    .m_start_dir      = std::move(start_dir),
+                                    .m_exe            = std::move(exe),
+                                    .m_launch_options = std::move(launch_options),
+                                    .m_icon           = std::move(icon),
+                                    .m_tags           = std::move(tags),
+                                    .m_last_play_time = std::move(last_play_time)};
 }
 }  // namespace
 
 namespace steam
 {
-// This is a very "son, we have a parser at home" kind of parser, very basic, but gets the job done...
-std::optional<std::vector<ShortcutsVdfEntry>> ShortcutsVdfEntry::scrapeShortcutsVdf(const QByteArray& contents)
+std::filesystem::path ShortcutsVdfEntry::getShortcutsVdfPath(const std::filesystem::path& steam_dir,
+                                                             const SteamId&               user_id)
 {
-    const auto app_ids{scrapeAppIds(contents)};
-    const auto app_names{scrapeAppNames(contents)};
-    const auto start_dirs{scrapeStartDirs(contents)};
-
-    if (!app_ids || !app_names || !start_dirs)
-    {
-        return std::nullopt;
-    }
+    return steam_dir / "userdata" / user_id.toSteamId32().toStdString() / "config" / "shortcuts.vdf";
+}
 
-    if (app_names->size() != app_ids->size() || app_ids->size() != start_dirs->size())
+std::optional<std::vector<ShortcutsVdfEntry>> ShortcutsVdfEntry::scrapeShortcutsVdf(const QByteArray& contents)
+{
+    // The file is a single "shortcuts" map, containing a map for every shortcut, keyed by its index
+    BinaryVdfReader reader{contents};
+    const auto      root_type{reader.readType()};
+    const auto      root_key{reader.readString()};
+    if (root_type != VdfType::Map || !root_key || !keyIs(*root_key, "shortcuts"))
     {
-        qCWarning(lc::steam) << "Failed to scrape shortcuts.vdf - list size mismatch!";
+        qCWarning(lc::steam) << "Failed to parse shortcuts.vdf - unexpected root entry!";
         return std::nullopt;
     }
 
     std::vector<ShortcutsVdfEntry> data;
-    for (std::size_t i{0}; i < app_ids->size(); ++i)
+    while (true)
     {
-        data.emplace_back(AppId{(*app_ids)[i]}, (*app_names)[i], (*start_dirs)[i]);
+        const auto type{reader.readType()};
+        if (!type)
+        {
+            qCWarning(lc::steam) << "Failed to parse shortcuts.vdf - unexpected end of data!";
+            return std::nullopt;
+        }
+
+        if (isMapEnd(*type))
+        {
+            break;
+        }
+
+        if (!reader.readString())
+        {
+            qCWarning(lc::steam) << "Failed to parse shortcuts.vdf - malformed entry key!";
+            return std::nullopt;
+        }
+
+        if (*type != VdfType::Map)
+        {
+            if (!reader.skipValue(*type))
+            {
+                qCWarning(lc::steam) << "Failed to parse shortcuts.vdf - malformed value!";
+                return std::nullopt;
+            }
+            continue;
+        }
+
+        auto entry{readEntry(reader)};
+        if (!entry)
+        {
+            qCWarning(lc::steam) << "Failed to parse shortcuts.vdf - malformed shortcut entry!";
+            return std::nullopt;
+        }
+
+        if (!*entry)
+        {
+            qCDebug(lc::steam) << "Skipping shortcuts.vdf entry without an appid.";
+            continue;
+        }
+
+        data.push_back(std::move(**entry));
     }
 
     return data;
@@ -190,8 +411,7 @@ std::optional<std::vector<ShortcutsVdfEntry>>
         return std::nullopt;
     }
 
-    const auto shortcuts_file{steam_dir / "userdata" / user_id.toSteamId32().toStdString() / "config"
-                              / "shortcuts.vdf"};
+    const auto shortcuts_file{getShortcutsVdfPath(steam_dir, user_id)};
     const auto last_modified_ts{QFileInfo{shortcuts_file}.lastModified()};
 
     if (const auto cache_it{entry_cache.find(shortcuts_file)}; cache_it != entry_cache.end())
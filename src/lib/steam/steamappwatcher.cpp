@@ -3,6 +3,7 @@
 
 // system/Qt includes
 #include <QFile>
+#include <QFileInfo>
 
 // local includes
 #include "common/loggingcategories.h"
@@ -44,6 +45,13 @@ std::optional<steam::AppId>
         return app_id;
     }
 
+    // Without a start directory the path would be relative to our own working directory
+    if (found_entry->m_start_dir.isEmpty())
+    {
+        qCInfo(lc::steam) << "shortcuts.vdf entry for" << app_id.getGameId() << "has no start directory.";
+        return app_id;
+    }
+
     QFile file{std::filesystem::path{found_entry->m_start_dir.toStdString()} / "steam_appid.txt"};
     if (!file.exists())
     {
@@ -70,13 +78,11 @@ SteamAppWatcher::SteamAppWatcher(const SteamProcessTracker& process_tracker, con
     , m_app_id{app_id}
     , m_metadata{std::nullopt}
 {
-    connect(&m_check_timer, &QTimer::timeout, this, &SteamAppWatcher::slotCheckState);
-
-    m_check_timer.setInterval(500);
-    m_check_timer.setSingleShot(true);
+    connect(&m_process_tracker, &SteamProcessTracker::signalProcessStateChanged, this,
+            &SteamAppWatcher::slotProcessStateChanged);
 
     qCInfo(lc::steam) << "Started watching AppID:" << m_app_id.getId();
-    slotCheckState();
+    slotProcessStateChanged();
 }
 
 SteamAppWatcher::~SteamAppWatcher()
@@ -110,8 +116,6 @@ const AppId& SteamAppWatcher::getAppId() const
 
 void SteamAppWatcher::slotCheckState()
 {
-    const auto auto_start_timer{qScopeGuard([this]() { m_check_timer.start(); })};
-
     auto new_state{enums::AppState::Stopped};
     if (const auto* log_trackers{m_process_tracker.getLogTrackers()})
     {
@@ -137,9 +141,37 @@ void SteamAppWatcher::slotCheckState()
                           << "detected:" << enums::qEnumToString(m_current_state) << "->"
                           << enums::qEnumToString(new_state);
         m_current_state = new_state;
+
+        // The log's modification time is the closest thing we have to when Steam actually changed the state
+        if (const auto* tracker{qobject_cast<const SteamLogTracker*>(sender())})
+        {
+            const QFileInfo log_info{tracker->getMainFilename()};
+            qCDebug(lc::steam) << "[TRACKING] App state for AppID" << m_app_id.getId() << "updated"
+                               << log_info.lastModified().msecsTo(QDateTime::currentDateTime())
+                               << "ms after it was logged.";
+        }
+
+        emit signalAppStateChanged();
     }
 }
 
+void SteamAppWatcher::slotCheckAppState(const AppId& app_id)
+{
+    // Until the metadata is resolved (e.g. the SteamId is not known yet), every change is worth a retry
+    if (m_metadata && m_metadata->m_trackable_app_id != app_id)
+    {
+        return;
+    }
+
+    slotCheckState();
+}
+
+void SteamAppWatcher::slotProcessStateChanged()
+{
+    connectToLogTrackers();
+    slotCheckState();
+}
+
 std::optional<SteamAppWatcher::TrackingMetadata>
     SteamAppWatcher::TrackingMetadata::fromAppId(const SteamProcessTracker::LogTrackers& log_trackers,
                                                  const std::filesystem::path& steam_dir, const AppId& app_id)
@@ -180,4 +212,29 @@ enums::AppState SteamAppWatcher::getAppState(const SteamProcessTracker::LogTrack
 
     return new_state;
 }
+
+void SteamAppWatcher::connectToLogTrackers()
+{
+    const auto* log_trackers{m_process_tracker.getLogTrackers()};
+    if (log_trackers == m_connected_log_trackers)
+    {
+        return;
+    }
+
+    // Connections to the old trackers are gone together with them, so only the new ones need to be made
+    m_connected_log_trackers = log_trackers;
+    if (!log_trackers)
+    {
+        return;
+    }
+
+    connect(&log_trackers->m_content_log, &SteamContentLogTracker::signalAppStateChanged, this,
+            &SteamAppWatcher::slotCheckAppState);
+    connect(&log_trackers->m_shader_log, &SteamShaderLogTracker::signalShaderCompilationChanged, this,
+            &SteamAppWatcher::slotCheckAppState);
+    connect(&log_trackers->m_gameprocess_log, &SteamGameProcessLogTracker::signalRunningProcessesChanged, this,
+            &SteamAppWatcher::slotCheckAppState);
+    connect(&log_trackers->m_connection_log, &SteamConnectionLogTracker::signalSteamIdChanged, this,
+            &SteamAppWatcher::slotCheckState);
+}
 }  // namespace steam
@@ -5,7 +5,16 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QProcess>
+#include <QRegularExpression>
 #include <QSettings>
+#include <QStandardPaths>
+#if defined(Q_OS_LINUX)
+    #include <cerrno>
+    #include <climits>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 // local includes
 #include "common/appsettings.h"
@@ -13,6 +22,9 @@
 
 namespace
 {
+constexpr std::chrono::seconds FLATPAK_CHECK_TIMEOUT{10};
+const QString                  FLATPAK_APP_ID{"com.valvesoftware.Steam"};
+
 bool setupProcess(const QString& exec, const QStringList& args, const QMap<QString, QString>& env_overrides,
                   QProcess& process)
 {
@@ -40,134 +52,162 @@ bool setupProcess(const QString& exec, const QStringList& args, const QMap<QStri
     return true;
 }
 
-#if defined(Q_OS_LINUX)
-std::optional<QString> execute(const QString& exec, const QStringList& args,
-                               const QMap<QString, QString>& env_overrides = {})
+bool executeDetached(const QString& exec, const QStringList& args, const QMap<QString, QString>& env_overrides = {})
 {
     QProcess process;
     if (!setupProcess(exec, args, env_overrides, process))
     {
-        return std::nullopt;
+        return false;
     }
 
-    process.setProcessChannelMode(QProcess::SeparateChannels);
-    process.start();
-    if (!process.waitForStarted())
+    process.setStandardOutputFile(QProcess::nullDevice());
+    process.setStandardErrorFile(QProcess::nullDevice());
+
+    return process.startDetached();
+}
+
+#if defined(Q_OS_LINUX)
+QByteArray quoteArg(const QString& arg)
+{
+    // The client splits the command line on whitespace, unless it is quoted
+    static const QRegularExpression needs_quoting{R"([\s"\\])"};
+    if (!arg.isEmpty() && !arg.contains(needs_quoting))
     {
-        qCWarning(lc::steam) << "waitForStarted() failed with" << process.errorString();
-        return std::nullopt;
+        return arg.toUtf8();
     }
 
-    process.waitForFinished();
-    if (process.state() != QProcess::NotRunning)
+    QByteArray quoted{arg.toUtf8()};
+    quoted.replace('\\', "\\\\").replace('"', "\\\"");
+    return '"' + quoted + '"';
+}
+#endif
+
+bool writeToSteamPipe(const QString& pipe_path, const QStringList& args)
+{
+#if defined(Q_OS_WIN)
+    Q_UNUSED(pipe_path);
+    Q_UNUSED(args);
+    return false;
+#elif defined(Q_OS_LINUX)
+    if (pipe_path.isEmpty())
     {
-        qCWarning(lc::steam) << "waitForFinished() timed out - killing executable!";
-        process.close();
-        return std::nullopt;
+        return false;
     }
 
-    if (const auto output{process.readAllStandardError().trimmed()}; !output.isEmpty())
+    // Running client reads the forwarded command lines from its pipe, the same way the `steam` executable does it
+    QByteArray command{"steam"};
+    for (const auto& arg : args)
     {
-        qCInfo(lc::steam).noquote() << "Captured stderr:\n-----\n" << QString{output} << "\n-----";
+        command += ' ' + quoteArg(arg);
     }
+    command += '\n';
 
-    if (const auto exit_code{process.exitCode()}; exit_code != 0)
+    if (command.size() > PIPE_BUF)
     {
-        qCWarning(lc::steam) << "Executable exited with error code" << exit_code;
-        return std::nullopt;
+        // Larger writes are not atomic and could get interleaved with other writers
+        return false;
     }
 
-    if (auto output{process.readAllStandardOutput().trimmed()}; !output.isEmpty())
+    // Opening a FIFO without a reader fails with ENXIO, which means that Steam is not running
+    const int fd{::open(pipe_path.toLocal8Bit().constData(), O_WRONLY | O_NONBLOCK | O_CLOEXEC)};
+    if (fd < 0)
     {
-        qCDebug(lc::steam).noquote() << "Captured stdout:\n-----\n" << QString{output} << "\n-----";
-        return output;
+        if (errno != ENOENT && errno != ENXIO)
+        {
+            qCWarning(lc::steam) << "failed to open" << pipe_path << "-" << lc::getErrorString(errno);
+        }
+        return false;
     }
 
-    return QString{};
-}
-#endif
+    struct stat info{};
+    const bool is_fifo{fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode)};
+    const auto written{is_fifo ? ::write(fd, command.constData(), command.size()) : -1};
+    const int write_error{errno};
+    ::close(fd);
 
-bool executeDetached(const QString& exec, const QStringList& args, const QMap<QString, QString>& env_overrides = {})
-{
-    QProcess process;
-    if (!setupProcess(exec, args, env_overrides, process))
+    if (written == command.size())
     {
-        return false;
+        qCInfo(lc::steam) << "Forwarded to" << pipe_path << "args:" << args;
+        return true;
     }
 
-    process.setStandardOutputFile(QProcess::nullDevice());
-    process.setStandardErrorFile(QProcess::nullDevice());
-
-    return process.startDetached();
+    if (is_fifo)
+    {
+        qCWarning(lc::steam) << "failed to write to" << pipe_path << "-" << lc::getErrorString(write_error);
+    }
+    return false;
+#else
+    #error OS is not supported!
+#endif
 }
 
+#if defined(Q_OS_WIN)
 QStringList findSteamExecutable()
 {
-#if defined(Q_OS_WIN)
     const QSettings settings(R"(HKEY_CURRENT_USER\Software\Valve\Steam)", QSettings::NativeFormat);
     if (const auto exec{settings.value("SteamExe").toString()}; !exec.isEmpty())
     {
         return {exec};
     }
     return {};
+}
+#endif
+
+QStringList getExecutableLocations()
+{
+#if defined(Q_OS_WIN)
+    // Registry is cheap to read, nothing to watch
+    return {};
 #elif defined(Q_OS_LINUX)
-    if (const auto steam_bin{execute("which", {"steam"})}; steam_bin && !steam_bin->isEmpty())
+    QStringList locations{qEnvironmentVariable("PATH").split(':', Qt::SkipEmptyParts)};
+    for (const auto& flatpak_dir : {QStringLiteral("/var/lib/flatpak"), QDir::homePath() + "/.local/share/flatpak"})
     {
-        return {*steam_bin};
+        locations += flatpak_dir + "/app";
+        locations += flatpak_dir + "/exports/bin";
     }
-    if (const auto flatpak_bin{execute("which", {"flatpak"})}; flatpak_bin && !flatpak_bin->isEmpty())
-    {
-        if (execute(*flatpak_bin, {"info", "com.valvesoftware.Steam"}))
-        {
-            return {*flatpak_bin, "run", "com.valvesoftware.Steam"};
-        }
-    }
-    return {};
+
+    locations.removeIf([](const QString& location) { return !QFileInfo{location}.isDir(); });
+    locations.removeDuplicates();
+    return locations;
 #else
     #error OS is not supported!
 #endif
 }
+}  // namespace
 
-QStringList getSteamExecutableWithArgs(const common::AppSettings& app_settings)
+namespace steam
 {
-    if (const auto& exec{app_settings.m_user_settings.m_steam_exec_override}; !exec.isEmpty())
-    {
-        if (QFileInfo::exists(exec))
-        {
-            return {exec};
-        }
+SteamCommandProxy::SteamCommandProxy(const common::AppSettings& app_settings)
+    : m_app_settings{app_settings}
+{
+    connect(&m_resolve_timer, &QTimer::timeout, this, &SteamCommandProxy::slotResolveSteamExecutable);
+    connect(&m_flatpak_check_timer, &QTimer::timeout, this, &SteamCommandProxy::slotHandleFlatpakCheckTimeout);
+    connect(&m_exec_location_watcher, &QFileSystemWatcher::directoryChanged, &m_resolve_timer,
+            qOverload<>(&QTimer::start));
 
-        // Executable was set, there is no need to look for fallbacks.
-        return {};
-    }
+    // Installations touch a lot of files, so wait for them to settle down
+    m_resolve_timer.setInterval(1000);
+    m_resolve_timer.setSingleShot(true);
+
+    m_flatpak_check_timer.setInterval(FLATPAK_CHECK_TIMEOUT);
+    m_flatpak_check_timer.setSingleShot(true);
 
-    return findSteamExecutable();
+    watchExecutableLocations();
+    slotResolveSteamExecutable();
 }
 
-bool executeSteamCommand(const common::AppSettings& app_settings, const QStringList& steam_args,
-                         const QMap<QString, QString>& env_overrides = {})
+SteamCommandProxy::~SteamCommandProxy()
 {
-    auto exec_with_args{getSteamExecutableWithArgs(app_settings)};
-    if (exec_with_args.isEmpty())
+    // The process is killed by its destructor, but we no longer care about its signals
+    if (m_flatpak_check)
     {
-        return false;
+        m_flatpak_check->disconnect(this);
     }
-
-    const auto exec{exec_with_args.takeFirst()};
-    return executeDetached(exec, exec_with_args + steam_args, env_overrides);
-}
-}  // namespace
-
-namespace steam
-{
-SteamCommandProxy::SteamCommandProxy(const common::AppSettings& app_settings)
-    : m_app_settings{app_settings}
-{
 }
 
 bool SteamCommandProxy::canExecuteCommands() const
 {
-    return !getSteamExecutableWithArgs(m_app_settings).isEmpty();
+    return !getSteamExecutableWithArgs().isEmpty() || !getSteamPipePath().isEmpty();
 }
 
 bool SteamCommandProxy::launchSteam(const bool big_picture_mode, const QString& username,
@@ -185,13 +225,12 @@ bool SteamCommandProxy::launchSteam(const bool big_picture_mode, const QString&
         args += {"-login", username};
     }
 
-    return executeSteamCommand(m_app_settings, args, env_overrides);
+    return executeSteamCommand(args, env_overrides);
 }
 
 bool SteamCommandProxy::launchApp(const AppId& app_id, const QMap<QString, QString>& env_overrides)
 {
-    return executeSteamCommand(m_app_settings,
-                               app_id.isGameId()
+    return executeSteamCommand(app_id.isGameId()
                                    ? QStringList{"steam://rungameid/" + QString::number(app_id.getId())}
                                    : QStringList{"steam://launch/" + QString::number(app_id.getId()) + "/dialog"},
                                env_overrides);
@@ -199,11 +238,221 @@ bool SteamCommandProxy::launchApp(const AppId& app_id, const QMap<QString, QStri
 
 bool SteamCommandProxy::close()
 {
-    return executeSteamCommand(m_app_settings, {"steam://exit"});
+    return executeSteamCommand({"steam://exit"});
 }
 
 bool SteamCommandProxy::closeBigPictureMode()
 {
-    return executeSteamCommand(m_app_settings, {"steam://close/bigpicture"});
+    return executeSteamCommand({"steam://close/bigpicture"});
+}
+
+void SteamCommandProxy::slotResolveSteamExecutable()
+{
+    m_resolve_timer.stop();
+    stopFlatpakCheck();
+
+    // PATH entries and flatpak directories might have been created in the meantime
+    watchExecutableLocations();
+
+#if defined(Q_OS_WIN)
+    setResolvedSteamExecutable(findSteamExecutable());
+#elif defined(Q_OS_LINUX)
+    if (const auto steam_bin{QStandardPaths::findExecutable("steam")}; !steam_bin.isEmpty())
+    {
+        setResolvedSteamExecutable({steam_bin});
+        return;
+    }
+
+    const auto flatpak_bin{QStandardPaths::findExecutable("flatpak")};
+    if (flatpak_bin.isEmpty())
+    {
+        setResolvedSteamExecutable({});
+        return;
+    }
+
+    // `flatpak info` can take a while, so it must never block the event loop
+    m_flatpak_check = std::make_unique<QProcess>();
+    setupProcess(flatpak_bin, {"info", FLATPAK_APP_ID}, {}, *m_flatpak_check);
+    m_flatpak_check->setProcessChannelMode(QProcess::SeparateChannels);
+
+    connect(m_flatpak_check.get(), &QProcess::finished, this, &SteamCommandProxy::slotHandleFlatpakCheckFinished);
+    connect(m_flatpak_check.get(), &QProcess::errorOccurred, this, &SteamCommandProxy::slotHandleFlatpakCheckError);
+
+    m_flatpak_check_timer.start();
+    m_flatpak_check->start();
+#else
+    #error OS is not supported!
+#endif
+}
+
+void SteamCommandProxy::slotHandleFlatpakCheckFinished(const int exit_code, const QProcess::ExitStatus exit_status)
+{
+    if (!m_flatpak_check)
+    {
+        return;
+    }
+
+    if (const auto output{m_flatpak_check->readAllStandardError().trimmed()}; !output.isEmpty())
+    {
+        qCInfo(lc::steam).noquote() << "Captured stderr:\n-----\n" << QString{output} << "\n-----";
+    }
+
+    const bool is_installed{exit_status == QProcess::NormalExit && exit_code == 0};
+    if (!is_installed)
+    {
+        qCInfo(lc::steam) << "Flatpak Steam is not available, exit code:" << exit_code;
+    }
+
+    const auto flatpak_bin{m_flatpak_check->program()};
+    stopFlatpakCheck();
+    setResolvedSteamExecutable(is_installed ? QStringList{flatpak_bin, "run", FLATPAK_APP_ID} : QStringList{});
+}
+
+void SteamCommandProxy::slotHandleFlatpakCheckError(const QProcess::ProcessError error)
+{
+    // Other errors are followed by the finished signal
+    if (!m_flatpak_check || error != QProcess::FailedToStart)
+    {
+        return;
+    }
+
+    qCWarning(lc::steam) << "Failed to start flatpak check -" << m_flatpak_check->errorString();
+    stopFlatpakCheck();
+    setResolvedSteamExecutable({});
+}
+
+void SteamCommandProxy::slotHandleFlatpakCheckTimeout()
+{
+    if (!m_flatpak_check)
+    {
+        return;
+    }
+
+    qCWarning(lc::steam) << "Flatpak check timed out - killing executable!";
+    stopFlatpakCheck();
+    setResolvedSteamExecutable({});
+}
+
+QStringList SteamCommandProxy::getSteamExecutableWithArgs() const
+{
+    if (const auto& exec{m_app_settings.m_user_settings.m_steam_exec_override}; !exec.isEmpty())
+    {
+        if (QFileInfo::exists(exec))
+        {
+            return {exec};
+        }
+
+        // Executable was set, there is no need to look for fallbacks.
+        return {};
+    }
+
+#if defined(Q_OS_WIN)
+    // Steam might have been installed after we have started
+    if (m_resolved_steam_exec.isEmpty())
+    {
+        return findSteamExecutable();
+    }
+#endif
+
+    // The previous result is kept while it is being re-resolved, but it might have been uninstalled in the meantime
+    if (!m_resolved_steam_exec.isEmpty() && !QFileInfo::exists(m_resolved_steam_exec.first()))
+    {
+        return {};
+    }
+
+    return m_resolved_steam_exec;
+}
+
+QString SteamCommandProxy::getSteamPipePath() const
+{
+#if defined(Q_OS_WIN)
+    return {};
+#elif defined(Q_OS_LINUX)
+    const QString native_pipe{QDir::homePath() + "/.steam/steam.pipe"};
+    const QString flatpak_pipe{QDir::homePath() + "/.var/app/" + FLATPAK_APP_ID + "/.steam/steam.pipe"};
+
+    // Only the client of the install that we would otherwise execute may receive the command
+    if (const auto exec_with_args{getSteamExecutableWithArgs()}; !exec_with_args.isEmpty())
+    {
+        return exec_with_args.contains(FLATPAK_APP_ID) ? flatpak_pipe : native_pipe;
+    }
+
+    // The pipe does not need the executable, as long as it is clear which install the client belongs to
+    const bool has_native_pipe{QFileInfo{native_pipe}.exists()};
+    const bool has_flatpak_pipe{QFileInfo{flatpak_pipe}.exists()};
+    if (has_native_pipe != has_flatpak_pipe)
+    {
+        return has_native_pipe ? native_pipe : flatpak_pipe;
+    }
+
+    return {};
+#else
+    #error OS is not supported!
+#endif
+}
+
+bool SteamCommandProxy::executeSteamCommand(const QStringList& steam_args, const QMap<QString, QString>& env_overrides)
+{
+    // Spawning a new Steam process just to forward the command is slow, so talk to the running client directly.
+    // The pipe cannot carry the environment though, so the executable has to take care of the overrides.
+    if (env_overrides.empty() && writeToSteamPipe(getSteamPipePath(), steam_args))
+    {
+        return true;
+    }
+
+    auto exec_with_args{getSteamExecutableWithArgs()};
+    if (exec_with_args.isEmpty())
+    {
+        return false;
+    }
+
+    const auto exec{exec_with_args.takeFirst()};
+    return executeDetached(exec, exec_with_args + steam_args, env_overrides);
+}
+
+void SteamCommandProxy::setResolvedSteamExecutable(const QStringList& exec_with_args)
+{
+    m_resolved_steam_exec = exec_with_args;
+    if (m_resolved_steam_exec.isEmpty())
+    {
+        qCInfo(lc::steam) << "Steam executable could not be found.";
+        return;
+    }
+
+    qCInfo(lc::steam) << "Resolved Steam executable:" << m_resolved_steam_exec;
+}
+
+void SteamCommandProxy::stopFlatpakCheck()
+{
+    m_flatpak_check_timer.stop();
+    if (!m_flatpak_check)
+    {
+        return;
+    }
+
+    // The process might still be emitting signals, so it is destroyed later
+    m_flatpak_check->disconnect(this);
+    m_flatpak_check->kill();
+    m_flatpak_check.release()->deleteLater();
+}
+
+void SteamCommandProxy::watchExecutableLocations()
+{
+    const auto locations{getExecutableLocations()};
+    const auto watched{m_exec_location_watcher.directories()};
+
+    QStringList new_locations;
+    for (const auto& location : locations)
+    {
+        if (!watched.contains(location))
+        {
+            new_locations += location;
+        }
+    }
+
+    if (!new_locations.isEmpty())
+    {
+        m_exec_location_watcher.addPaths(new_locations);
+    }
 }
 }  // namespace steam
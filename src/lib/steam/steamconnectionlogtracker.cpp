@@ -3,10 +3,12 @@
 
 // system/Qt includes
 #include <QRegularExpression>
+#include <ranges>
 
 // local includes
 #include "common/enums.h"
 #include "common/loggingcategories.h"
+#include "json/json.h"
 
 namespace steam
 {
@@ -22,15 +24,18 @@ const std::optional<SteamId>& SteamConnectionLogTracker::getCurrentSteamId() con
     return m_current_steam_id;
 }
 
-void SteamConnectionLogTracker::onLogChanged(const std::vector<QString>& new_lines)
+void SteamConnectionLogTracker::onLogChanged(const std::vector<QByteArrayView>& new_lines)
 {
+    // Only the latest entry matters, so there is no need to look at (and convert) the older lines
     std::optional<SteamId> new_steam_id;
-    for (const QString& line : new_lines)
+    for (const QByteArrayView raw_line : new_lines | std::views::reverse)
     {
-        static const QRegularExpression regex{R"(^(?:\[[^\]]*\]\s*){2}\[([^\]]+)\])"};
-        if (const auto match{regex.match(line)}; match.hasMatch())
+        // Any whitespace can separate the groups, so there is no literal that would narrow it down
+        static const LinePattern pattern{{}, R"(^(?:\[[^\]]*\]\s*){2}\[([^\]]+)\])"};
+        if (const auto match{matchLine(pattern, raw_line)}; match.hasMatch())
         {
             new_steam_id = SteamId::fromString(match.captured(1));
+            break;
         }
     }
 
@@ -38,6 +43,37 @@ void SteamConnectionLogTracker::onLogChanged(const std::vector<QString>& new_lin
     {
         qCInfo(lc::steam).noquote().nospace() << "User SteamId changed:\n" << new_steam_id->toString();
         m_current_steam_id = new_steam_id;
+        emit signalSteamIdChanged();
     }
 }
+
+QString SteamConnectionLogTracker::saveState() const
+{
+    const auto steam_id{m_current_steam_id ? std::make_optional(m_current_steam_id->toSteamId64()) : std::nullopt};
+    return json::toJson(steam_id).value_or(QString{});
+}
+
+bool SteamConnectionLogTracker::restoreState(const QString& state)
+{
+    const auto steam_id{json::fromJson<std::optional<QString>>(state)};
+    if (!steam_id)
+    {
+        return false;
+    }
+
+    if (!steam_id->has_value())
+    {
+        m_current_steam_id = std::nullopt;
+        return true;
+    }
+
+    const auto current_steam_id{SteamId::fromString(**steam_id)};
+    if (!current_steam_id)
+    {
+        return false;
+    }
+
+    m_current_steam_id = current_steam_id;
+    return true;
+}
 }  // namespace steam
@@ -7,6 +7,16 @@
 // local includes
 #include "common/enums.h"
 #include "common/loggingcategories.h"
+#include "json/json.h"
+
+namespace ext_linkage_for_glaze
+{
+struct ContentLogAppState
+{
+    std::uint64_t                           m_app_id{0};
+    steam::SteamContentLogTracker::AppState m_state{steam::SteamContentLogTracker::AppState::Stopped};
+};
+}  // namespace ext_linkage_for_glaze
 
 namespace steam
 {
@@ -81,7 +91,7 @@ SteamContentLogTracker::AppState SteamContentLogTracker::getAppState(const AppId
     return it != std::end(m_app_states) ? it->second : AppState::Stopped;
 }
 
-void SteamContentLogTracker::onLogChanged(const std::vector<QString>& new_lines)
+void SteamContentLogTracker::onLogChanged(const std::vector<QByteArrayView>& new_lines)
 {
     static const auto known_states{[]()
                                    {
@@ -100,16 +110,15 @@ void SteamContentLogTracker::onLogChanged(const std::vector<QString>& new_lines)
                                    }()};
 
     std::map<AppId, QVector<AppStateChange>> new_change_states;
-    for (const QString& line : new_lines)
+    for (const QByteArrayView raw_line : new_lines)
     {
-        static const QRegularExpression mode_regex{R"(AppID\s(\d+)\sstate\schanged\s:\s(.*),)"};
-        const auto                      match{mode_regex.match(line)};
-        if (match.hasMatch())
+        static const LinePattern mode_pattern{{"changed"}, R"(AppID\s(\d+)\sstate\schanged\s:\s(.*),)"};
+        if (const auto match{matchLine(mode_pattern, raw_line)}; match.hasMatch())
         {
             const auto app_id{AppId::fromString(match.captured(1))};
             if (!app_id)
             {
-                qCWarning(lc::steam) << "Failed to get AppID from" << line;
+                qCWarning(lc::steam) << "Failed to get AppID from" << QString::fromUtf8(raw_line);
                 continue;
             }
 
@@ -146,6 +155,7 @@ void SteamContentLogTracker::onLogChanged(const std::vector<QString>& new_lines)
                               << "logged:" << enums::qEnumToString(AppState::Stopped) << "->"
                               << enums::qEnumToString(app_state);
             m_app_states[app_id] = app_state;
+            emit signalAppStateChanged(app_id, app_state);
             continue;
         }
 
@@ -164,6 +174,36 @@ void SteamContentLogTracker::onLogChanged(const std::vector<QString>& new_lines)
         {
             it->second = app_state;
         }
+        emit signalAppStateChanged(app_id, app_state);
+    }
+}
+
+QString SteamContentLogTracker::saveState() const
+{
+    std::vector<ext_linkage_for_glaze::ContentLogAppState> states;
+    for (const auto& [app_id, app_state] : m_app_states)
+    {
+        states.push_back({.m_app_id = app_id.getId(), .m_state = app_state});
+    }
+
+    return json::toJson(states).value_or(QString{});
+}
+
+bool SteamContentLogTracker::restoreState(const QString& state)
+{
+    const auto states{json::fromJson<std::vector<ext_linkage_for_glaze::ContentLogAppState>>(state)};
+    if (!states)
+    {
+        return false;
     }
+
+    std::map<AppId, AppState> app_states;
+    for (const auto& [app_id, app_state] : *states)
+    {
+        app_states[AppId{app_id}] = app_state;
+    }
+
+    m_app_states = std::move(app_states);
+    return true;
 }
 }  // namespace steam
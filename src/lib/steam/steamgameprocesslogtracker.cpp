@@ -4,9 +4,20 @@
 // system/Qt includes
 #include <QDebug>
 #include <QRegularExpression>
+#include <set>
 
 // local includes
 #include "common/loggingcategories.h"
+#include "json/json.h"
+
+namespace ext_linkage_for_glaze
+{
+struct GameProcessLogAppPids
+{
+    std::uint64_t     m_app_id{0};
+    std::vector<uint> m_pids;
+};
+}  // namespace ext_linkage_for_glaze
 
 namespace steam
 {
@@ -15,6 +26,8 @@ SteamGameProcessLogTracker::SteamGameProcessLogTracker(const std::filesystem::pa
     : SteamLogTracker(logs_dir / "gameprocess_log.txt", logs_dir / "gameprocess_log.previous.txt",
                       std::move(first_entry_time_filter))
 {
+    connect(&m_exit_watcher, &os::ProcessExitWatcher::signalProcessExited, this,
+            &SteamGameProcessLogTracker::slotHandleProcessExited);
 }
 
 bool SteamGameProcessLogTracker::isAnyProcessRunning(const AppId& app_id) const
@@ -22,29 +35,29 @@ bool SteamGameProcessLogTracker::isAnyProcessRunning(const AppId& app_id) const
     return m_app_id_to_process_ids.contains(app_id);
 }
 
-void SteamGameProcessLogTracker::onLogChanged(const std::vector<QString>& new_lines)
+void SteamGameProcessLogTracker::onLogChanged(const std::vector<QByteArrayView>& new_lines)
 {
     const auto try_emplace_pid_list{[](std::map<AppId, QSet<uint>>& container, const AppId& app_id,
                                        const QSet<uint>& default_list = {}) -> QSet<uint>&
                                     { return container.try_emplace(app_id, default_list).first->second; }};
 
     std::map<AppId, QSet<uint>> initial_entries;
-    for (const QString& line : new_lines)
+    for (const QByteArrayView raw_line : new_lines)
     {
-        static const QRegularExpression add_regex{R"(AppID (\d+) adding PID (\d+))"};
-        if (const auto match{add_regex.match(line)}; match.hasMatch())
+        static const LinePattern add_pattern{{"adding PID"}, R"(AppID (\d+) adding PID (\d+))"};
+        if (const auto match{matchLine(add_pattern, raw_line)}; match.hasMatch())
         {
             const auto app_id{AppId::fromString(match.captured(1))};
             if (!app_id)
             {
-                qCWarning(lc::steam) << "Failed to get AppID from" << line;
+                qCWarning(lc::steam) << "Failed to get AppID from" << QString::fromUtf8(raw_line);
                 continue;
             }
 
             const auto pid{match.captured(2).toUInt()};
             if (pid == 0)
             {
-                qCWarning(lc::steam) << "Failed to get PID from" << line;
+                qCWarning(lc::steam) << "Failed to get PID from" << QString::fromUtf8(raw_line);
                 continue;
             }
 
@@ -55,14 +68,15 @@ void SteamGameProcessLogTracker::onLogChanged(const std::vector<QString>& new_li
             continue;
         }
 
-        static const QRegularExpression remove_regex{
+        static const LinePattern remove_pattern{
+            {"going away", "no longer"},
             R"((?:Game \d+ going away.* PID (\d+))|(?:AppID \d+ no longer.* PID (\d+)))"};
-        if (const auto match{remove_regex.match(line)}; match.hasMatch())
+        if (const auto match{matchLine(remove_pattern, raw_line)}; match.hasMatch())
         {
             const auto pid{(match.hasCaptured(1) ? match.captured(1) : match.captured(2)).toUInt()};
             if (pid == 0)
             {
-                qCWarning(lc::steam) << "Failed to get PID from" << line;
+                qCWarning(lc::steam) << "Failed to get PID from" << QString::fromUtf8(raw_line);
                 continue;
             }
 
@@ -97,10 +111,99 @@ void SteamGameProcessLogTracker::onLogChanged(const std::vector<QString>& new_li
             }
         }
 
-        if (data_it->second.empty())
+        const bool any_running{!data_it->second.empty()};
+        if (!any_running)
         {
             m_app_id_to_process_ids.erase(data_it);
         }
+
+        if (initial_pids.empty() == any_running)
+        {
+            emit signalRunningProcessesChanged(app_id, any_running);
+        }
+    }
+
+    updateExitWatches();
+}
+
+QString SteamGameProcessLogTracker::saveState() const
+{
+    std::vector<ext_linkage_for_glaze::GameProcessLogAppPids> app_pids;
+    for (const auto& [app_id, pids] : m_app_id_to_process_ids)
+    {
+        app_pids.push_back({.m_app_id = app_id.getId(), .m_pids = {std::begin(pids), std::end(pids)}});
+    }
+
+    return json::toJson(app_pids).value_or(QString{});
+}
+
+bool SteamGameProcessLogTracker::restoreState(const QString& state)
+{
+    const auto app_pids{json::fromJson<std::vector<ext_linkage_for_glaze::GameProcessLogAppPids>>(state)};
+    if (!app_pids)
+    {
+        return false;
+    }
+
+    std::map<AppId, QSet<uint>> app_id_to_process_ids;
+    for (const auto& [app_id, pids] : *app_pids)
+    {
+        app_id_to_process_ids[AppId{app_id}] = QSet<uint>{std::begin(pids), std::end(pids)};
+    }
+
+    m_app_id_to_process_ids = std::move(app_id_to_process_ids);
+    updateExitWatches();
+    return true;
+}
+
+void SteamGameProcessLogTracker::slotHandleProcessExited(const uint pid)
+{
+    qCInfo(lc::steam) << "Process" << pid << "has exited.";
+    removePid(pid);
+}
+
+void SteamGameProcessLogTracker::updateExitWatches()
+{
+    std::set<uint> tracked_pids;
+    for (const auto& [app_id, pids] : m_app_id_to_process_ids)
+    {
+        tracked_pids.insert(std::begin(pids), std::end(pids));
+    }
+
+    for (const auto pid : m_exit_watcher.getPids())
+    {
+        if (!tracked_pids.contains(pid))
+        {
+            m_exit_watcher.unwatch(pid);
+        }
+    }
+
+    // The log remains the source of truth for additions, but the exit can be detected much sooner
+    for (const auto pid : tracked_pids)
+    {
+        if (m_exit_watcher.watch(pid) == os::ProcessExitWatcher::WatchResult::NotRunning)
+        {
+            qCInfo(lc::steam) << "Process" << pid << "is no longer running.";
+            removePid(pid);
+        }
+    }
+}
+
+void SteamGameProcessLogTracker::removePid(const uint pid)
+{
+    for (auto it = std::begin(m_app_id_to_process_ids); it != std::end(m_app_id_to_process_ids);)
+    {
+        if (!it->second.remove(pid) || !it->second.empty())
+        {
+            ++it;
+            continue;
+        }
+
+        const AppId app_id{it->first};
+        it = m_app_id_to_process_ids.erase(it);
+
+        qCInfo(lc::steam) << "Running processes removed for AppID:" << app_id.getId();
+        emit signalRunningProcessesChanged(app_id, false);
     }
 }
 }  // namespace steam
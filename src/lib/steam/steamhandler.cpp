@@ -10,7 +10,9 @@
 namespace steam
 {
 SteamHandler::SteamHandler(const common::AppSettings& app_settings)
-    : m_command_proxy{app_settings}
+    : m_close_steam_deadline{app_settings.m_user_settings.m_close_steam_deadline_sec}
+    , m_command_proxy{app_settings}
+    , m_steam_process_tracker{std::filesystem::path{app_settings.m_app_metadata.getCacheDir().toStdString()}}
 {
     connect(&m_steam_process_tracker, &SteamProcessTracker::signalProcessStateChanged, this,
             &SteamHandler::slotSteamProcessStateChanged);
@@ -69,6 +71,7 @@ bool SteamHandler::close()
         {
             if (m_command_proxy.close())
             {
+                m_steam_process_tracker.startShutdownDeadline(m_close_steam_deadline);
                 return true;
             }
 
@@ -82,7 +85,7 @@ bool SteamHandler::close()
         return true;
     }
 
-    m_steam_process_tracker.close();
+    m_steam_process_tracker.close(m_close_steam_deadline);
     return true;
 }
 
@@ -179,13 +182,16 @@ bool SteamHandler::launchApp(const AppId& app_id, const QMap<QString, QString>&
     }
 
     m_session_data = {.m_steam_app_watcher{std::make_unique<SteamAppWatcher>(m_steam_process_tracker, app_id)}};
+    connect(m_session_data.m_steam_app_watcher.get(), &SteamAppWatcher::signalAppStateChanged, this,
+            &SteamHandler::signalAppDataChanged);
+    emit signalAppDataChanged();
     return true;
 }
 
 void SteamHandler::clearSessionData()
 {
     qCInfo(lc::steam) << "Clearing session data...";
-    m_session_data = {};
+    resetSessionData();
 }
 
 std::optional<std::map<AppId, QString>> SteamHandler::getNonSteamAppData(const SteamId& user_id) const
@@ -217,6 +223,17 @@ std::optional<std::map<AppId, QString>> SteamHandler::getNonSteamAppData(const S
     return std::nullopt;
 }
 
+std::optional<std::filesystem::path> SteamHandler::getNonSteamAppDataPath(const SteamId& user_id) const
+{
+    const auto steam_dir{m_steam_process_tracker.getSteamDir()};
+    if (steam_dir.empty())
+    {
+        return std::nullopt;
+    }
+
+    return ShortcutsVdfEntry::getShortcutsVdfPath(steam_dir, user_id);
+}
+
 std::optional<SteamId> SteamHandler::getCurrentUserId() const
 {
     if (const auto* log_trackers{m_steam_process_tracker.getLogTrackers()})
@@ -229,6 +246,7 @@ std::optional<SteamId> SteamHandler::getCurrentUserId() const
 
 void SteamHandler::slotSteamProcessStateChanged()
 {
+    connectToLogTrackers();
     if (m_steam_process_tracker.isRunning())
     {
         qCInfo(lc::steam) << "Steam is running! PID:" << m_steam_process_tracker.getPid()
@@ -237,8 +255,41 @@ void SteamHandler::slotSteamProcessStateChanged()
     else
     {
         qCInfo(lc::steam) << "Steam is no longer running!";
-        m_session_data = {};
+        resetSessionData();
         emit signalSteamClosed();
     }
 }
+
+void SteamHandler::connectToLogTrackers()
+{
+    const auto* log_trackers{m_steam_process_tracker.getLogTrackers()};
+    if (log_trackers == m_connected_log_trackers)
+    {
+        return;
+    }
+
+    // UI mode and user are no longer the same if the trackers have changed
+    m_connected_log_trackers = log_trackers;
+    emit signalSteamUiModeChanged();
+    emit signalCurrentUserChanged();
+
+    if (!log_trackers)
+    {
+        return;
+    }
+
+    connect(&log_trackers->m_web_helper, &SteamWebHelperLogTracker::signalSteamUiModeChanged, this,
+            &SteamHandler::signalSteamUiModeChanged);
+    connect(&log_trackers->m_connection_log, &SteamConnectionLogTracker::signalSteamIdChanged, this,
+            &SteamHandler::signalCurrentUserChanged);
+}
+
+void SteamHandler::resetSessionData()
+{
+    if (m_session_data.m_steam_app_watcher)
+    {
+        m_session_data = {};
+        emit signalAppDataChanged();
+    }
+}
 }  // namespace steam
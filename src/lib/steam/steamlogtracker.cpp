@@ -2,15 +2,47 @@
 #include "steam/steamlogtracker.h"
 
 // system/Qt includes
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
-#include <QRegularExpression>
+#include <QSaveFile>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <utility>
+#if defined(Q_OS_LINUX)
+    #include <cerrno>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 // local includes
 #include "common/loggingcategories.h"
+#include "json/json.h"
+
+namespace ext_linkage_for_glaze
+{
+struct SteamLogCheckpoint
+{
+    std::int64_t                m_session_time_key{0};
+    QString                     m_file_id;
+    std::int64_t                m_file_size{0};
+    std::int64_t                m_file_mtime{0};
+    std::int64_t                m_read_pos{0};
+    QString                     m_last_line_digest;
+    std::optional<std::int64_t> m_first_entry_time_filter;
+    QString                     m_state;
+};
+}  // namespace ext_linkage_for_glaze
 
 namespace
 {
+constexpr qsizetype MAX_RETAINED_BUFFER_SIZE{1024 * 1024};
+constexpr qint64    READ_CHUNK_SIZE{256 * 1024};
+constexpr qint64    MAX_DIGEST_LINE_SIZE{4096};
+constexpr int       CHECKPOINT_SAVE_DELAY_MS{5000};
+
 bool openForReading(QFile& file)
 {
     if (!file.exists())
@@ -19,7 +51,8 @@ bool openForReading(QFile& file)
         return false;
     }
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    // Lines are split manually, so there is no need for the text mode or Qt's own buffering
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
     {
         qCWarning(lc::steam) << "file" << file.fileName() << "could not be opened!";
         return false;
@@ -28,165 +61,542 @@ bool openForReading(QFile& file)
     return true;
 }
 
-QDateTime getDateTimeFromLogLine(const QString& line, const steam::SteamLogTracker::TimeFormat time_format)
+std::optional<int> parseDigits(const QByteArrayView text, const qsizetype offset, const qsizetype count)
 {
-    using enum steam::SteamLogTracker::TimeFormat;
-
-    switch (time_format)
+    int value{0};
+    for (qsizetype i = offset; i < offset + count; ++i)
     {
-        case YYYY_MM_DD_hh_mm_ss:
+        const char character{text[i]};
+        if (character < '0' || character > '9')
         {
-            static const QRegularExpression time_regex{R"(^\[(\d{4})-(\d{2})-(\d{2})\s(\d{2}):(\d{2}):(\d{2})\])"};
-            if (const auto match{time_regex.match(line)}; match.hasMatch())
-            {
-                const QDate date{match.captured(1).toInt(), match.captured(2).toInt(), match.captured(3).toInt()};
-                const QTime time{match.captured(4).toInt(), match.captured(5).toInt(), match.captured(6).toInt()};
-                return QDateTime{date, time};
-            }
+            return std::nullopt;
         }
+
+        value = value * 10 + (character - '0');
     }
+    return value;
+}
 
-    return QDateTime{};
+qint64 toTimeKey(const std::chrono::year_month_day& date, const std::chrono::milliseconds time_of_day)
+{
+    // The key is a "naive" local time, the same way the logs are written - no timezone lookup is needed to compare
+    // them with each other.
+    const auto days{std::chrono::sys_days{date}.time_since_epoch()};
+    return std::chrono::duration_cast<std::chrono::milliseconds>(days + time_of_day).count();
 }
 
-qint64 readAllLines(std::vector<QString>& lines, QFile& file)
+std::optional<qint64> toTimeKey(const QDateTime& datetime)
 {
-    QTextStream stream{&file};
-    QString     line;
+    if (!datetime.isValid())
+    {
+        return std::nullopt;
+    }
+
+    const QDateTime local_datetime{datetime.toLocalTime()};
+    const QDate     date{local_datetime.date()};
+    return toTimeKey(std::chrono::year{date.year()} / date.month() / date.day(),
+                     std::chrono::milliseconds{local_datetime.time().msecsSinceStartOfDay()});
+}
 
-    stream.seek(0);
+std::optional<qint64> getTimeKeyFromLogLine(const QByteArrayView line,
+                                            const steam::SteamLogTracker::TimeFormat time_format)
+{
+    using enum steam::SteamLogTracker::TimeFormat;
 
-    while (stream.readLineInto(&line))
+    switch (time_format)
     {
-        if (!line.isEmpty())
+        case YYYY_MM_DD_hh_mm_ss:
         {
-            lines.push_back(line);
+            // [YYYY-MM-DD hh:mm:ss]
+            constexpr qsizetype prefix_size{21};
+            if (line.size() < prefix_size || line[0] != '[' || line[5] != '-' || line[8] != '-'
+                || (line[11] != ' ' && line[11] != '\t') || line[14] != ':' || line[17] != ':' || line[20] != ']')
+            {
+                return std::nullopt;
+            }
+
+            const auto year{parseDigits(line, 1, 4)};
+            const auto month{parseDigits(line, 6, 2)};
+            const auto day{parseDigits(line, 9, 2)};
+            const auto hours{parseDigits(line, 12, 2)};
+            const auto minutes{parseDigits(line, 15, 2)};
+            const auto seconds{parseDigits(line, 18, 2)};
+            if (!year || !month || !day || !hours || !minutes || !seconds)
+            {
+                return std::nullopt;
+            }
+
+            const std::chrono::year_month_day date{std::chrono::year{*year},
+                                                   std::chrono::month{static_cast<unsigned int>(*month)},
+                                                   std::chrono::day{static_cast<unsigned int>(*day)}};
+            if (!date.ok() || *hours > 23 || *minutes > 59 || *seconds > 59)
+            {
+                return std::nullopt;
+            }
+
+            return toTimeKey(date, std::chrono::hours{*hours} + std::chrono::minutes{*minutes}
+                                       + std::chrono::seconds{*seconds});
         }
     }
 
-    return stream.pos();
+    return std::nullopt;
 }
 
-bool isLineBeforeDatetime(const QString& line, const QDateTime& datetime,
+bool isLineAtOrAfterTimeKey(const QByteArrayView line, const qint64 time_key,
+                            const steam::SteamLogTracker::TimeFormat time_format)
+{
+    const auto log_time_key{getTimeKeyFromLogLine(line, time_format)};
+    return log_time_key && *log_time_key >= time_key;
+}
+
+void filterRemainingLines(std::vector<QByteArrayView>& lines, std::optional<qint64>& first_entry_time_filter,
                           const steam::SteamLogTracker::TimeFormat time_format)
 {
-    const QDateTime logtime{getDateTimeFromLogLine(line, time_format)};
-    if (!logtime.isValid())
+    if (!first_entry_time_filter)
     {
-        return false;
+        return;
     }
 
-    return logtime < datetime;
+    const auto line_it{std::ranges::find_if(
+        lines, [&](const auto& line) { return isLineAtOrAfterTimeKey(line, *first_entry_time_filter, time_format); })};
+    if (line_it != std::end(lines))
+    {
+        first_entry_time_filter = std::nullopt;
+    }
+
+    lines.erase(std::begin(lines), line_it);
 }
 
-bool isLineAtOrAfterDatetime(const QString& line, const QDateTime& datetime,
-                             const steam::SteamLogTracker::TimeFormat time_format)
+qint64 readBytes(QFile& file, const qint64 offset, const qint64 max_size, QByteArray& buffer)
 {
-    const QDateTime logtime{getDateTimeFromLogLine(line, time_format)};
-    if (!logtime.isValid())
+    const qint64 available{std::min(file.size() - offset, max_size)};
+    if (available <= 0)
     {
-        return false;
+        return 0;
     }
 
-    return logtime >= datetime;
-}
+    const auto begin{buffer.size()};
+    buffer.resize(begin + available);
 
-void filterLines(std::vector<QString>& lines, QDateTime& datetime, const steam::SteamLogTracker::TimeFormat time_format)
-{
-    auto line_rit = std::rbegin(lines);
-    for (; line_rit != std::rend(lines); ++line_rit)
+    qint64 total{0};
+#if defined(Q_OS_LINUX)
+    while (total < available)
     {
-        if (isLineBeforeDatetime(*line_rit, datetime, time_format))
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        const auto result{::pread(file.handle(), buffer.data() + begin + total,
+                                  static_cast<std::size_t>(available - total), offset + total)};
+        if (result < 0 && errno == EINTR)
         {
-            break;
+            continue;
         }
-    }
 
-    auto line_it = line_rit == std::rend(lines) ? std::begin(lines) : line_rit.base() /* next element */;
-    for (; line_it != std::end(lines); ++line_it)
-    {
-        if (isLineAtOrAfterDatetime(*line_it, datetime, time_format))
+        if (result <= 0)
         {
-            datetime = {};
+            if (result < 0)
+            {
+                qCWarning(lc::steam) << "failed to read from" << file.fileName() << "-" << lc::getErrorString(errno);
+            }
             break;
         }
+
+        total += result;
     }
+#else
+    if (file.seek(offset))
+    {
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        total = std::max(qint64{0}, file.read(buffer.data() + begin, available));
+    }
+#endif
 
-    lines.erase(std::begin(lines), line_it);
+    buffer.resize(begin + total);
+    return total;
 }
 
-qint64 readRemainingLines(std::vector<QString>& lines, QFile& file, QDateTime& first_entry_time_filter,
-                          const steam::SteamLogTracker::TimeFormat time_format, const qint64 start_offset)
+struct LineSearchResult
 {
-    QTextStream stream{&file};
-    QString     line;
-
-    // Start reading from the last position we've read.
-    stream.seek(start_offset);
+    qint64 m_offset{0};
+    bool   m_found{false};
+};
 
-    while (stream.readLineInto(&line))
+LineSearchResult findFirstLineAtOrAfterBackwards(QFile& file, const qint64 time_key,
+                                                 const steam::SteamLogTracker::TimeFormat time_format)
+{
+    // Scan the file backwards chunk by chunk until a line older than the key is found. Only the current chunk and
+    // the incomplete line that continues into the previously read chunk are kept in memory.
+    std::optional<qint64> result;
+    qint64                tail_start{-1};
+    qint64                end{file.size()};
+    QByteArray            buffer;
+    while (end > 0)
     {
-        if (!line.isEmpty())
+        const qint64 start{std::max(qint64{0}, end - READ_CHUNK_SIZE)};
+
+        QByteArray chunk;
+        if (readBytes(file, start, end - start, chunk) != end - start)
         {
-            if (first_entry_time_filter.isValid())
+            // The file has changed under our feet, just read everything that we did not rule out
+            return {result.value_or(0), true};
+        }
+
+        buffer.prepend(chunk);
+
+        const QByteArrayView view{buffer};
+        qsizetype            line_end{view.size()};
+        while (true)
+        {
+            const qsizetype newline{line_end > 0 ? view.lastIndexOf('\n', line_end - 1) : -1};
+            if (newline < 0 && start > 0)
             {
-                if (!isLineAtOrAfterDatetime(line, first_entry_time_filter, time_format))
+                // The line starts somewhere in the next chunk
+                break;
+            }
+
+            if (tail_start < 0 && newline >= 0)
+            {
+                tail_start = start + newline + 1;
+            }
+
+            const qsizetype line_begin{newline + 1};
+            if (const auto line_key{getTimeKeyFromLogLine(view.sliced(line_begin, line_end - line_begin), time_format)})
+            {
+                if (*line_key < time_key)
                 {
-                    continue;
+                    return {result.value_or(std::max(qint64{0}, tail_start)), result.has_value()};
                 }
 
-                first_entry_time_filter = {};
+                result = start + line_begin;
             }
 
-            lines.push_back(line);
+            if (newline < 0)
+            {
+                break;
+            }
+
+            line_end = newline;
         }
+
+        buffer.truncate(line_end);
+        end = start;
+    }
+
+    return {result.value_or(0), result.has_value()};
+}
+
+LineSearchResult findFirstLineAtOrAfter(QFile& file, const std::optional<qint64>& time_key,
+                                        const steam::SteamLogTracker::TimeFormat time_format)
+{
+    if (!time_key)
+    {
+        return {0, true};
+    }
+
+    const qint64 size{file.size()};
+    if (size <= 0)
+    {
+        return {0, false};
+    }
+
+    uchar* mapped{file.map(0, size)};
+    if (mapped == nullptr)
+    {
+        qCDebug(lc::steam) << "could not map" << file.fileName() << "for searching -" << file.errorString();
+        return findFirstLineAtOrAfterBackwards(file, *time_key, time_format);
+    }
+
+    const auto unmap{qScopeGuard([&file, mapped]() { file.unmap(mapped); })};
+    // NOLINTNEXTLINE(*-reinterpret-cast)
+    const QByteArrayView data{reinterpret_cast<const char*>(mapped), size};
+
+    const auto next_line_start{[&data](const qsizetype offset)
+                               {
+                                   const auto newline{data.indexOf('\n', offset)};
+                                   return newline < 0 ? data.size() : newline + 1;
+                               }};
+    const auto line_start_at_or_after{
+        [&data, &next_line_start](const qsizetype offset)
+        { return offset == 0 || data[offset - 1] == '\n' ? offset : next_line_start(offset); }};
+    const auto line_at{[&data, &next_line_start](const qsizetype offset)
+                       { return data.sliced(offset, next_line_start(offset) - offset); }};
+
+    // Binary search over the line starts - lines without a timestamp (e.g. multiline entries) are skipped over.
+    // Invariants: every timestamped line starting before `low` is older than the key; the result (if any) starts
+    // before `end` or is the already found line.
+    std::optional<qsizetype> result;
+    qsizetype                low{0};
+    qsizetype                end{data.size()};
+    while (low < end)
+    {
+        const qsizetype mid{low + ((end - low) / 2)};
+
+        std::optional<qint64> line_key;
+        qsizetype             line_start{line_start_at_or_after(mid)};
+        for (; line_start < end; line_start = next_line_start(line_start))
+        {
+            line_key = getTimeKeyFromLogLine(line_at(line_start), time_format);
+            if (line_key)
+            {
+                break;
+            }
+        }
+
+        if (!line_key)
+        {
+            end = mid;
+        }
+        else if (*line_key >= *time_key)
+        {
+            result = line_start;
+            end    = mid;
+        }
+        else
+        {
+            low = next_line_start(line_start);
+        }
+    }
+
+    if (result)
+    {
+        return {*result, true};
+    }
+
+    // Nothing to read yet, except for the incomplete line at the end (if any)
+    return {data.lastIndexOf('\n') + 1, false};
+}
+
+void ensureTrailingNewline(QByteArray& buffer)
+{
+    // A backup file that ends without a newline must not be merged with the first line of the main file
+    if (!buffer.isEmpty() && !buffer.endsWith('\n'))
+    {
+        buffer.append('\n');
     }
+}
+
+QString getFileId(const QFile& file)
+{
+#if defined(Q_OS_LINUX)
+    struct stat file_stat{};
+    if (fstat(file.handle(), &file_stat) != 0)
+    {
+        return {};
+    }
+
+    return QString::number(file_stat.st_dev) + ":" + QString::number(file_stat.st_ino);
+#else
+    const auto birth_time{file.fileTime(QFileDevice::FileBirthTime)};
+    return birth_time.isValid() ? QString::number(birth_time.toMSecsSinceEpoch()) : QString{};
+#endif
+}
 
-    return stream.pos();
+std::int64_t getFileMTime(const QFile& file)
+{
+    const auto modified_at{file.fileTime(QFileDevice::FileModificationTime)};
+    return modified_at.isValid() ? modified_at.toMSecsSinceEpoch() : 0;
 }
 
-void tryWatchFileNatively(const QString& filename, QFileSystemWatcher& watcher)
+std::optional<QString> getLastLineDigest(QFile& file, const qint64 end_pos)
 {
-    // The file needs to be re-added sometimes if it was deleted or moved (very OS-dependent)
-    if (!watcher.files().contains(filename))
+    if (end_pos <= 0)
     {
-        // Adding path may fail sometimes. For example, inotify does not have enough resources on linux.
-        if (!watcher.addPath(filename))
+        return QString{};
+    }
+
+    const qint64 start{std::max(qint64{0}, end_pos - MAX_DIGEST_LINE_SIZE)};
+    QByteArray   data;
+    if (readBytes(file, start, end_pos - start, data) != end_pos - start || !data.endsWith('\n'))
+    {
+        return std::nullopt;
+    }
+
+    data.chop(1);
+    const auto line{QByteArrayView{data}.sliced(data.lastIndexOf('\n') + 1)};
+    return QString::fromLatin1(QCryptographicHash::hash(line, QCryptographicHash::Sha1).toHex());
+}
+
+qsizetype splitLines(const QByteArrayView bytes, std::vector<QByteArrayView>& lines)
+{
+    qsizetype begin{0};
+    while (begin < bytes.size())
+    {
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        const void* newline{std::memchr(bytes.data() + begin, '\n', static_cast<std::size_t>(bytes.size() - begin))};
+        if (newline == nullptr)
+        {
+            // The last line is incomplete - it will be read once the rest of it is written.
+            break;
+        }
+
+        const qsizetype end{static_cast<const char*>(newline) - bytes.data()};
+        auto            line{bytes.sliced(begin, end - begin)};
+        if (line.endsWith('\r'))
         {
-            qCDebug(lc::steam) << "could not use native file watcher for" << filename;
+            line.chop(1);
         }
+
+        if (!line.isEmpty())
+        {
+            lines.push_back(line);
+        }
+
+        begin = end + 1;
     }
+
+    return begin;
 }
 }  // namespace
 
 namespace steam
 {
+SteamLogTracker::LinePattern::LinePattern(const std::vector<QByteArray>& anchors, const QString& pattern)
+    : m_regex{pattern}
+{
+    for (const auto& anchor : anchors)
+    {
+        m_anchors.emplace_back(anchor);
+    }
+
+    // Compile the pattern right away instead of on the first match
+    m_regex.optimize();
+}
+
+bool SteamLogTracker::LinePattern::hasAnchor(const QByteArrayView line) const
+{
+    return m_anchors.empty()
+           || std::ranges::any_of(m_anchors, [&line](const auto& anchor) { return anchor.indexIn(line) >= 0; });
+}
+
+const QRegularExpression& SteamLogTracker::LinePattern::getRegex() const
+{
+    return m_regex;
+}
+
 SteamLogTracker::SteamLogTracker(std::filesystem::path main_filename, std::filesystem::path backup_filename,
                                  QDateTime first_entry_time_filter, TimeFormat time_format)
     : m_main_filename{std::move(main_filename)}
     , m_backup_filename{std::move(backup_filename)}
-    , m_first_entry_time_filter{std::move(first_entry_time_filter)}
+    , m_session_time_key{toTimeKey(first_entry_time_filter)}
+    , m_first_entry_time_filter{m_session_time_key}
     , m_time_format{time_format}
 {
-    connect(&m_file_watcher, &QFileSystemWatcher::fileChanged, this, &SteamLogTracker::slotCheckLog);
+    connect(&m_checkpoint_timer, &QTimer::timeout, this, &SteamLogTracker::saveCheckpoint);
+
+    m_checkpoint_timer.setInterval(CHECKPOINT_SAVE_DELAY_MS);
+    m_checkpoint_timer.setSingleShot(true);
 }
 
-void SteamLogTracker::slotCheckLog()
+SteamLogTracker::~SteamLogTracker()
 {
-    QFile      main_file{m_main_filename};
-    const auto file_watcher_restart_guard{qScopeGuard(
-        [this, &main_file]()
-        {
-            // It should be enough to only monitor the main file as the backup changes very rarely, worst case there
-            // will be a delay of 1 second...
-            tryWatchFileNatively(main_file.fileName(), m_file_watcher);
-        })};
+    qCDebug(lc::steam) << "parsing stats for" << m_main_filename.generic_string()
+                       << "- lines scanned:" << m_parsing_stats.m_lines_scanned
+                       << "| candidates:" << m_parsing_stats.m_candidate_lines
+                       << "| matched:" << m_parsing_stats.m_lines_matched
+                       << "| time spent (ms):" << (m_parsing_stats.m_time_spent_ns / 1000000);
+    if (m_latency_stats.m_samples > 0)
+    {
+        qCDebug(lc::steam) << "latency stats for" << m_main_filename.generic_string()
+                           << "- samples:" << m_latency_stats.m_samples << "| max (ms):" << m_latency_stats.m_max_ms
+                           << "| average (ms):"
+                           << (m_latency_stats.m_total_ms / static_cast<qint64>(m_latency_stats.m_samples));
+    }
+}
+
+const std::filesystem::path& SteamLogTracker::getMainFilename() const
+{
+    return m_main_filename;
+}
+
+const std::filesystem::path& SteamLogTracker::getBackupFilename() const
+{
+    return m_backup_filename;
+}
+
+const SteamLogTracker::LatencyStats& SteamLogTracker::getLatencyStats() const
+{
+    return m_latency_stats;
+}
+
+const SteamLogTracker::ParsingStats& SteamLogTracker::getParsingStats() const
+{
+    return m_parsing_stats;
+}
+
+void SteamLogTracker::setCheckpointFile(std::filesystem::path filepath)
+{
+    m_checkpoint_file = std::move(filepath);
+}
 
+void SteamLogTracker::saveCheckpoint()
+{
+    m_checkpoint_timer.stop();
+    if (m_checkpoint_file.empty() || !m_session_time_key || !m_initialized)
+    {
+        return;
+    }
+
+    QFile main_file{m_main_filename};
     if (!openForReading(main_file))
     {
         return;
     }
 
+    const auto last_line_digest{getLastLineDigest(main_file, m_last_read_pos)};
+    if (!last_line_digest)
+    {
+        qCDebug(lc::steam) << "could not compute the last line digest for" << m_main_filename.generic_string();
+        return;
+    }
+
+    // The modification time is only usable if nothing was written since the last read
+    const ext_linkage_for_glaze::SteamLogCheckpoint checkpoint{
+        .m_session_time_key        = *m_session_time_key,
+        .m_file_id                 = getFileId(main_file),
+        .m_file_size               = m_last_prev_size,
+        .m_file_mtime              = main_file.size() == m_last_prev_size ? getFileMTime(main_file) : 0,
+        .m_read_pos                = m_last_read_pos,
+        .m_last_line_digest        = *last_line_digest,
+        .m_first_entry_time_filter = m_first_entry_time_filter,
+        .m_state                   = saveState()};
+
+    const auto serialized{json::toJson(checkpoint)};
+    if (!serialized)
+    {
+        qCWarning(lc::steam) << "failed to serialize checkpoint for" << m_main_filename.generic_string() << "-"
+                             << serialized.error();
+        return;
+    }
+
+    const QString checkpoint_path{QString::fromStdString(m_checkpoint_file.generic_string())};
+    if (!QDir{}.mkpath(QString::fromStdString(m_checkpoint_file.parent_path().generic_string())))
+    {
+        qCWarning(lc::steam) << "failed to create directory for" << checkpoint_path;
+        return;
+    }
+
+    QSaveFile file{checkpoint_path};
+    if (!file.open(QIODevice::WriteOnly) || file.write(serialized->toUtf8()) < 0 || !file.commit())
+    {
+        qCWarning(lc::steam) << "failed to save checkpoint" << checkpoint_path << "-" << file.errorString();
+        return;
+    }
+
+    qCDebug(lc::steam) << "saved checkpoint for" << m_main_filename.generic_string() << "at offset"
+                       << m_last_read_pos;
+}
+
+bool SteamLogTracker::checkLog()
+{
+    QFile main_file{m_main_filename};
+    if (!openForReading(main_file))
+    {
+        return false;
+    }
+
+    if (!m_initialized && tryRestoreCheckpoint(main_file))
+    {
+        m_initialized = true;
+    }
+
     const auto current_main_file_size{main_file.size()};
     const bool was_main_file_appended{current_main_file_size > m_last_prev_size};
     const bool was_main_file_switched_with_backup{current_main_file_size < m_last_prev_size};
@@ -202,39 +612,58 @@ void SteamLogTracker::slotCheckLog()
             if (backup_file.exists())
             {
                 // Warning already logged.
-                return;
+                return false;
             }
 
             qCInfo(lc::steam) << "skipping file" << m_backup_filename.generic_string()
                               << "for initial read, because it does not exist.";
         }
 
-        std::vector<QString> lines;
+        // Only the part of the logs that was written after the start time is read, so the memory usage does not
+        // depend on how large the previous logs have grown.
+        bool search_main_file{true};
         if (backup_file.isOpen())
         {
-            readAllLines(lines, backup_file);
+            const auto result{findFirstLineAtOrAfter(backup_file, m_first_entry_time_filter, m_time_format)};
+            if (result.m_found)
+            {
+                readLines(backup_file, result.m_offset, true);
+                search_main_file = false;
+            }
         }
 
-        m_last_read_pos  = readAllLines(lines, main_file);
+        qint64 main_offset{0};
+        if (search_main_file)
+        {
+            main_offset = findFirstLineAtOrAfter(main_file, m_first_entry_time_filter, m_time_format).m_offset;
+        }
+
+        m_last_read_pos  = readLines(main_file, main_offset, false);
         m_last_prev_size = current_main_file_size;
+        m_initialized    = true;
+        if (!m_checkpoint_timer.isActive())
+        {
+            m_checkpoint_timer.start();
+        }
 
-        filterLines(lines, m_first_entry_time_filter, m_time_format);
-        onLogChanged(lines);
-        m_initialized = true;
-        return;
+        qCDebug(lc::steam) << "initial log read for" << m_main_filename.generic_string() << "finished, read"
+                           << (current_main_file_size - main_offset) << "bytes from the main file.";
+        return true;
     }
 
     if (was_main_file_appended)
     {
         qCDebug(lc::steam) << "file" << m_main_filename.generic_string() << "was appended.";
 
-        std::vector<QString> lines;
-        m_last_read_pos =
-            readRemainingLines(lines, main_file, m_first_entry_time_filter, m_time_format, m_last_read_pos);
+        m_last_read_pos  = readLines(main_file, m_last_read_pos, false);
         m_last_prev_size = current_main_file_size;
+        if (!m_checkpoint_timer.isActive())
+        {
+            m_checkpoint_timer.start();
+        }
 
-        onLogChanged(lines);
-        return;
+        updateLatencyStats(main_file);
+        return true;
     }
 
     if (was_main_file_switched_with_backup)
@@ -245,18 +674,186 @@ void SteamLogTracker::slotCheckLog()
         QFile backup_file{m_backup_filename};
         if (!openForReading(backup_file))
         {
-            return;
+            return false;
         }
 
-        std::vector<QString> lines;
-        readRemainingLines(lines, backup_file, m_first_entry_time_filter, m_time_format, m_last_read_pos);
-        m_last_read_pos  = readRemainingLines(lines, main_file, m_first_entry_time_filter, m_time_format, 0);
+        readLines(backup_file, m_last_read_pos, true);
+        m_last_read_pos  = readLines(main_file, 0, false);
         m_last_prev_size = current_main_file_size;
+        if (!m_checkpoint_timer.isActive())
+        {
+            m_checkpoint_timer.start();
+        }
 
-        onLogChanged(lines);
-        return;
+        updateLatencyStats(main_file);
+        return true;
     }
 
     qCDebug(lc::steam) << "file" << m_main_filename.generic_string() << "did not change.";
+    return false;
+}
+
+bool SteamLogTracker::tryRestoreCheckpoint(QFile& main_file)
+{
+    if (m_checkpoint_file.empty() || !m_session_time_key)
+    {
+        return false;
+    }
+
+    QFile file{m_checkpoint_file};
+    if (!file.exists())
+    {
+        return false;
+    }
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qCWarning(lc::steam) << "checkpoint" << file.fileName() << "could not be opened!";
+        return false;
+    }
+
+    const auto checkpoint{json::fromJson<ext_linkage_for_glaze::SteamLogCheckpoint>(QString::fromUtf8(file.readAll()))};
+    if (!checkpoint)
+    {
+        qCWarning(lc::steam) << "checkpoint" << file.fileName() << "could not be parsed -" << checkpoint.error();
+        return false;
+    }
+
+    const auto is_stale{[this, &main_file, &checkpoint]() -> std::optional<QString>
+                        {
+                            if (checkpoint->m_session_time_key != *m_session_time_key)
+                            {
+                                return "it belongs to a different Steam session";
+                            }
+
+                            if (checkpoint->m_file_id != getFileId(main_file))
+                            {
+                                return "the log file was replaced";
+                            }
+
+                            const auto size{main_file.size()};
+                            if (size < checkpoint->m_file_size || checkpoint->m_read_pos > checkpoint->m_file_size)
+                            {
+                                return "the log file was truncated";
+                            }
+
+                            if (size == checkpoint->m_file_size && checkpoint->m_file_mtime != 0
+                                && checkpoint->m_file_mtime != getFileMTime(main_file))
+                            {
+                                return "the log file was rewritten";
+                            }
+
+                            if (getLastLineDigest(main_file, checkpoint->m_read_pos) != checkpoint->m_last_line_digest)
+                            {
+                                return "the last read line does not match";
+                            }
+
+                            if (!restoreState(checkpoint->m_state))
+                            {
+                                return "the tracker state could not be restored";
+                            }
+
+                            return std::nullopt;
+                        }};
+
+    if (const auto reason{is_stale()})
+    {
+        qCInfo(lc::steam) << "ignoring checkpoint for" << m_main_filename.generic_string() << "because" << *reason;
+        return false;
+    }
+
+    m_last_read_pos           = checkpoint->m_read_pos;
+    m_last_prev_size          = checkpoint->m_file_size;
+    m_first_entry_time_filter = checkpoint->m_first_entry_time_filter;
+
+    qCInfo(lc::steam) << "resuming" << m_main_filename.generic_string() << "from checkpoint at offset"
+                      << m_last_read_pos;
+    return true;
+}
+
+qint64 SteamLogTracker::readLines(QFile& file, qint64 offset, const bool include_incomplete_line)
+{
+    const auto cleanup{qScopeGuard(
+        [this]()
+        {
+            // The views must never outlive the buffer data
+            m_lines.clear();
+            m_read_buffer.resize(0);
+            if (m_read_buffer.capacity() > MAX_RETAINED_BUFFER_SIZE)
+            {
+                m_read_buffer.squeeze();
+                m_lines.shrink_to_fit();
+            }
+        })};
+
+    // The data is handed over in chunks, so that only a chunk (plus an incomplete line) is kept in memory at once
+    while (true)
+    {
+        const bool end_of_file{readBytes(file, offset + m_read_buffer.size(), READ_CHUNK_SIZE, m_read_buffer) == 0};
+        if (end_of_file && include_incomplete_line)
+        {
+            ensureTrailingNewline(m_read_buffer);
+        }
+
+        const auto consumed{splitLines(m_read_buffer, m_lines)};
+        filterRemainingLines(m_lines, m_first_entry_time_filter, m_time_format);
+        if (!m_lines.empty())
+        {
+            QElapsedTimer timer;
+            timer.start();
+
+            onLogChanged(m_lines);
+
+            m_parsing_stats.m_lines_scanned += m_lines.size();
+            m_parsing_stats.m_time_spent_ns += timer.nsecsElapsed();
+            m_lines.clear();
+        }
+
+        m_read_buffer.remove(0, consumed);
+        offset += consumed;
+
+        if (end_of_file)
+        {
+            return offset;
+        }
+    }
+}
+
+QRegularExpressionMatch SteamLogTracker::matchLine(const LinePattern& pattern, const QByteArrayView line)
+{
+    if (!pattern.hasAnchor(line))
+    {
+        return {};
+    }
+
+    ++m_parsing_stats.m_candidate_lines;
+    auto match{pattern.getRegex().match(QString::fromUtf8(line))};
+    if (match.hasMatch())
+    {
+        ++m_parsing_stats.m_lines_matched;
+    }
+
+    return match;
+}
+
+void SteamLogTracker::updateLatencyStats(const QFile& file)
+{
+    // The modification time is the best approximation we have for when the last line was written. The resolution
+    // depends on the filesystem, but it's good enough to see whether the updates arrive within milliseconds or not.
+    const QDateTime modified_at{file.fileTime(QFileDevice::FileModificationTime)};
+    if (!modified_at.isValid())
+    {
+        return;
+    }
+
+    const qint64 latency_ms{std::max(qint64{0}, modified_at.msecsTo(QDateTime::currentDateTime()))};
+
+    m_latency_stats.m_last_ms = latency_ms;
+    m_latency_stats.m_max_ms  = std::max(m_latency_stats.m_max_ms, latency_ms);
+    m_latency_stats.m_total_ms += latency_ms;
+    ++m_latency_stats.m_samples;
+
+    qCDebug(lc::steam) << "file" << m_main_filename.generic_string() << "processed" << latency_ms
+                       << "ms after it was written.";
 }
 }  // namespace steam
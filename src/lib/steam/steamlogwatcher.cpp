@@ -0,0 +1,257 @@
+// header file include
+#include "steam/steamlogwatcher.h"
+
+// system/Qt includes
+#include <algorithm>
+#include <array>
+#if defined(Q_OS_LINUX)
+    #include <cerrno>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+// local includes
+#include "common/loggingcategories.h"
+#include "steam/steamlogtracker.h"
+
+namespace
+{
+constexpr std::chrono::milliseconds MIN_POLL_INTERVAL{50};
+constexpr std::chrono::milliseconds MAX_POLL_INTERVAL{1000};
+
+void tryWatchFileNatively(const QString& filename, QFileSystemWatcher& watcher)
+{
+    // The file needs to be re-added sometimes if it was deleted or moved (very OS-dependent)
+    if (!watcher.files().contains(filename))
+    {
+        // Adding path may fail sometimes. For example, the file does not exist yet.
+        if (!watcher.addPath(filename))
+        {
+            qCDebug(lc::steam) << "could not use native file watcher for" << filename;
+        }
+    }
+}
+}  // namespace
+
+namespace steam
+{
+SteamLogWatcher::SteamLogWatcher(std::filesystem::path logs_dir)
+    : m_logs_dir{std::move(logs_dir)}
+{
+    connect(&m_poll_timer, &QTimer::timeout, this, &SteamLogWatcher::slotPoll);
+    connect(&m_file_watcher, &QFileSystemWatcher::fileChanged, this, &SteamLogWatcher::slotHandleFileChanged);
+
+    m_poll_timer.setSingleShot(true);
+    m_poll_timer.setInterval(MIN_POLL_INTERVAL);
+
+    if (!tryStartNativeWatch())
+    {
+        startPolling();
+    }
+}
+
+SteamLogWatcher::~SteamLogWatcher()
+{
+    stopNativeWatch();
+}
+
+void SteamLogWatcher::addTracker(SteamLogTracker& tracker)
+{
+    m_trackers.push_back(&tracker);
+    if (!isUsingNativeEvents())
+    {
+        tryWatchFileNatively(QString::fromStdString(tracker.getMainFilename().generic_string()), m_file_watcher);
+    }
+}
+
+bool SteamLogWatcher::isUsingNativeEvents() const
+{
+    return m_native_notifier != nullptr;
+}
+
+void SteamLogWatcher::slotCheckAllLogs()
+{
+    checkLogs(m_trackers);
+}
+
+void SteamLogWatcher::slotHandleNativeEvents()
+{
+#if defined(Q_OS_LINUX)
+    std::vector<SteamLogTracker*> changed_trackers;
+    bool                          check_all{false};
+    bool                          watch_lost{false};
+
+    const auto add_changed_tracker{
+        [this, &changed_trackers](const std::string_view filename)
+        {
+            for (auto* tracker : m_trackers)
+            {
+                if (tracker->getMainFilename().filename().native() != filename
+                    && tracker->getBackupFilename().filename().native() != filename)
+                {
+                    continue;
+                }
+
+                if (std::ranges::find(changed_trackers, tracker) == std::end(changed_trackers))
+                {
+                    changed_trackers.push_back(tracker);
+                }
+            }
+        }};
+
+    // Drain everything that has accumulated so that every tracker is checked at most once per batch.
+    alignas(inotify_event) std::array<char, 4096> buffer{};
+    while (true)
+    {
+        const auto length{read(m_native_fd, buffer.data(), buffer.size())};
+        if (length <= 0)
+        {
+            if (length < 0 && errno != EAGAIN && errno != EINTR)
+            {
+                qCWarning(lc::steam) << "failed to read inotify events for" << m_logs_dir.generic_string() << "-"
+                                     << lc::getErrorString(errno);
+                watch_lost = true;
+            }
+            break;
+        }
+
+        for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);)
+        {
+            // NOLINTNEXTLINE(*-reinterpret-cast, *-pointer-arithmetic)
+            const auto* event{reinterpret_cast<const inotify_event*>(buffer.data() + offset)};
+            offset += sizeof(inotify_event) + event->len;
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                check_all = true;
+                continue;
+            }
+
+            if ((event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) != 0)
+            {
+                watch_lost = true;
+                continue;
+            }
+
+            if (event->len > 0)
+            {
+                // The name is NUL-terminated and might have additional padding.
+                // NOLINTNEXTLINE(*-array-to-pointer-decay, *-no-array-decay)
+                add_changed_tracker(std::string_view{event->name});
+            }
+        }
+    }
+
+    if (watch_lost)
+    {
+        qCWarning(lc::steam) << "lost native watch for" << m_logs_dir.generic_string() << "- falling back to polling.";
+        stopNativeWatch();
+        startPolling();
+        check_all = true;
+    }
+
+    checkLogs(check_all ? m_trackers : changed_trackers);
+#endif
+}
+
+void SteamLogWatcher::slotHandleFileChanged(const QString& path)
+{
+    for (auto* tracker : m_trackers)
+    {
+        if (QString::fromStdString(tracker->getMainFilename().generic_string()) == path)
+        {
+            checkLogs({tracker});
+            break;
+        }
+    }
+
+    // Something is happening, so we poll more aggressively for a while
+    m_poll_timer.setInterval(MIN_POLL_INTERVAL);
+    if (m_poll_timer.isActive())
+    {
+        m_poll_timer.start();
+    }
+}
+
+void SteamLogWatcher::slotPoll()
+{
+    const bool changed{checkLogs(m_trackers)};
+    for (const auto* tracker : m_trackers)
+    {
+        tryWatchFileNatively(QString::fromStdString(tracker->getMainFilename().generic_string()), m_file_watcher);
+    }
+
+    // Poll often while the logs are being written to and back off gradually once they go quiet
+    m_poll_timer.setInterval(changed ? MIN_POLL_INTERVAL
+                                     : std::min(m_poll_timer.intervalAsDuration() * 2, MAX_POLL_INTERVAL));
+    m_poll_timer.start();
+}
+
+bool SteamLogWatcher::tryStartNativeWatch()
+{
+#if defined(Q_OS_LINUX)
+    if (isUsingNativeEvents())
+    {
+        return true;
+    }
+
+    const int fd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)};
+    if (fd < 0)
+    {
+        qCWarning(lc::steam) << "failed to initialize inotify -" << lc::getErrorString(errno);
+        return false;
+    }
+
+    constexpr std::uint32_t mask{IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR};
+    if (inotify_add_watch(fd, m_logs_dir.c_str(), mask) < 0)
+    {
+        qCWarning(lc::steam) << "failed to watch" << m_logs_dir.generic_string() << "with inotify -"
+                             << lc::getErrorString(errno);
+        ::close(fd);
+        return false;
+    }
+
+    m_native_fd       = fd;
+    m_native_notifier = std::make_unique<QSocketNotifier>(m_native_fd, QSocketNotifier::Read);
+    connect(m_native_notifier.get(), &QSocketNotifier::activated, this, &SteamLogWatcher::slotHandleNativeEvents);
+
+    qCDebug(lc::steam) << "watching" << m_logs_dir.generic_string() << "with inotify.";
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SteamLogWatcher::stopNativeWatch()
+{
+#if defined(Q_OS_LINUX)
+    m_native_notifier.reset();
+    if (m_native_fd >= 0)
+    {
+        ::close(m_native_fd);
+        m_native_fd = -1;
+    }
+#endif
+}
+
+void SteamLogWatcher::startPolling()
+{
+    for (const auto* tracker : m_trackers)
+    {
+        tryWatchFileNatively(QString::fromStdString(tracker->getMainFilename().generic_string()), m_file_watcher);
+    }
+
+    m_poll_timer.setInterval(MIN_POLL_INTERVAL);
+    m_poll_timer.start();
+}
+
+bool SteamLogWatcher::checkLogs(const std::vector<SteamLogTracker*>& trackers)
+{
+    bool changed{false};
+    for (auto* tracker : trackers)
+    {
+        changed = tracker->checkLog() || changed;
+    }
+    return changed;
+}
+}  // namespace steam
@@ -3,7 +3,9 @@
 
 // system/Qt includes
 #include <QDir>
+#include <QFile>
 #include <QRegularExpression>
+#include <QSettings>
 #include <algorithm>
 
 // local includes
@@ -11,6 +13,9 @@
 
 namespace
 {
+constexpr std::chrono::milliseconds CHECK_INTERVAL{1000};
+constexpr std::chrono::seconds      UNRESOLVED_STEAM_RETRY_INTERVAL{5};
+
 std::filesystem::path getSteamDir(const QString& exec_path)
 {
     QDir dir{exec_path};
@@ -30,25 +35,76 @@ std::filesystem::path getSteamDir(const QString& exec_path)
 
     return {};
 }
+
+std::optional<uint> getPidReportedBySteam()
+{
+    bool converted{false};
+    uint pid{0};
+
+#if defined(Q_OS_WIN)
+    const QSettings settings(R"(HKEY_CURRENT_USER\Software\Valve\Steam\ActiveProcess)", QSettings::NativeFormat);
+    pid = settings.value("pid").toUInt(&converted);
+#elif defined(Q_OS_LINUX)
+    QFile file{QDir::homePath() + "/.steam/steam.pid"};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+
+    pid = file.readAll().trimmed().toUInt(&converted);
+#else
+    #error OS is not supported!
+#endif
+
+    // The value is left behind after Steam exits, so it can only be used as a hint
+    return converted && pid != 0 ? std::make_optional(pid) : std::nullopt;
+}
 }  // namespace
 
 namespace steam
 {
-SteamProcessTracker::SteamProcessTracker()
-
+SteamProcessTracker::SteamProcessTracker(std::filesystem::path checkpoint_dir)
+    : m_checkpoint_dir{std::move(checkpoint_dir)}
 {
     connect(&m_check_timer, &QTimer::timeout, this, &SteamProcessTracker::slotCheckState);
+    connect(&m_process_handler, &os::ProcessHandler::signalProcessStarted, this,
+            &SteamProcessTracker::slotHandleProcessStarted);
+    connect(&m_process_handler, &os::ProcessHandler::signalProcessExited, this,
+            &SteamProcessTracker::slotHandleProcessExited);
+    connect(&m_process_handler, &os::ProcessHandler::signalProcessEventsLost, this,
+            &SteamProcessTracker::slotCheckState);
+    connect(&m_exit_watcher, &os::ProcessExitWatcher::signalProcessExited, this,
+            &SteamProcessTracker::slotHandleProcessExited);
 
-    m_check_timer.setInterval(1000);
     m_check_timer.setSingleShot(true);
 
+    connect(&m_shutdown_deadline_timer, &QTimer::timeout, this, &SteamProcessTracker::slotShutdownDeadlineReached);
+    m_shutdown_deadline_timer.setSingleShot(true);
+
+    // With process events there is no need to periodically scan all the processes
+    m_process_events_available = m_process_handler.startMonitoring();
+    if (!m_process_events_available)
+    {
+        qCInfo(lc::steam) << "Process events are not available, Steam process will be searched for periodically.";
+    }
+
     QTimer::singleShot(0, this, &SteamProcessTracker::slotCheckState);
 }
 
-// For forward declarations
-SteamProcessTracker::~SteamProcessTracker() = default;
+SteamProcessTracker::~SteamProcessTracker()
+{
+    // Has to be done here as the trackers can no longer provide their state while being destroyed
+    if (auto* log_trackers{m_data.m_log_trackers.get()})
+    {
+        log_trackers->m_web_helper.saveCheckpoint();
+        log_trackers->m_content_log.saveCheckpoint();
+        log_trackers->m_gameprocess_log.saveCheckpoint();
+        log_trackers->m_shader_log.saveCheckpoint();
+        log_trackers->m_connection_log.saveCheckpoint();
+    }
+}
 
-void SteamProcessTracker::close()
+void SteamProcessTracker::close(const std::chrono::seconds deadline)
 {
     slotCheckState();
     if (isRunning())
@@ -60,6 +116,26 @@ void SteamProcessTracker::close()
 #else
     #error OS is not supported!
 #endif
+        startShutdownDeadline(deadline);
+    }
+}
+
+void SteamProcessTracker::startShutdownDeadline(const std::chrono::seconds deadline)
+{
+    if (!isRunning())
+    {
+        return;
+    }
+
+    // Repeated requests should neither reset the measurement, nor postpone the escalation
+    if (!m_shutdown_elapsed.isValid())
+    {
+        m_shutdown_elapsed.start();
+    }
+
+    if (deadline.count() > 0 && !m_shutdown_deadline_timer.isActive())
+    {
+        m_shutdown_deadline_timer.start(deadline);
     }
 }
 
@@ -91,98 +167,237 @@ std::filesystem::path SteamProcessTracker::getSteamDir() const
 void SteamProcessTracker::slotCheckState()
 {
     m_check_timer.stop();
-    const auto auto_start_timer{qScopeGuard([this]() { m_check_timer.start(); })};
+    const auto auto_start_timer{qScopeGuard(
+        [this]()
+        {
+            const bool is_exit_watched{isRunning() && m_exit_watcher.isWatching(m_data.m_pid)};
+            if (!is_exit_watched && !m_process_handler.isMonitoring())
+            {
+                m_check_timer.start(CHECK_INTERVAL);
+            }
+            else if (!isRunning() && m_has_unresolved_steam)
+            {
+                // Process events will not tell us when the Steam directory becomes usable
+                m_check_timer.start(UNRESOLVED_STEAM_RETRY_INTERVAL);
+            }
+        })};
 
     if (isRunning())
     {
+        // The PID cannot be reused while we are holding on to it, so there is nothing to check
+        if (m_exit_watcher.isWatching(m_data.m_pid))
+        {
+            return;
+        }
+
         const auto start_time = m_process_handler.getStartTime(m_data.m_pid);
         if (m_data.m_start_time == start_time)
         {
             return;
         }
 
-        m_data = {};
-        emit signalProcessStateChanged();
+        clearProcessData();
     }
 
-    const auto pids{m_process_handler.getPids()};
-    for (const auto pid : pids)
+    m_has_unresolved_steam = false;
+    if (const auto pid{getPidReportedBySteam()}; pid && tryTrackProcess(*pid, m_process_handler.getStartTime(*pid)))
     {
-        const QString exec_path{m_process_handler.getExecPath(pid)};
-        if (exec_path.isEmpty())
-        {
-            continue;
-        }
+        return;
+    }
 
-        // clang-format off
-        static const QRegularExpression exec_regex{
-            R"((?:.+?steam\.exe$))"        // Windows
-            R"(|)"                         // OR
-            R"((?:.*?steam.+?steam$))",    // Linux
-            QRegularExpression::CaseInsensitiveOption};
-        // clang-format on
+    const auto snapshot{m_process_handler.getSnapshot()};
+    std::erase_if(m_non_steam_processes,
+                  [&snapshot](const auto& item) { return snapshot.find(item.first) == nullptr; });
 
-        if (!exec_path.contains(exec_regex))
+    for (const auto& entry : snapshot.getEntries())
+    {
+        if (tryTrackProcess(entry.m_pid, entry.m_start_time, entry.m_name))
         {
-            continue;
+            break;
         }
-        qCInfo(lc::steam) << "Found a matching Steam process. PATH:" << exec_path << "| PID:" << pid;
+    }
+}
 
-        auto cleanup{qScopeGuard([this]() { m_data = {}; })};
+void SteamProcessTracker::slotHandleProcessStarted(const uint pid)
+{
+    // The process has executed something else, so the previous verdict no longer applies
+    m_non_steam_processes.erase(pid);
+    if (isRunning())
+    {
+        return;
+    }
 
-        m_data.m_steam_dir = ::getSteamDir(exec_path);
-        if (m_data.m_steam_dir.empty())
-        {
-            qCInfo(lc::steam) << "Could not resolve steam directory for running Steam process, PID:" << pid;
-            continue;
-        }
+    // This runs for every executed process in the system, so the rest is only done for the likely candidates
+    const auto name{m_process_handler.getName(pid)};
+    if (!name.contains("steam", Qt::CaseInsensitive))
+    {
+        return;
+    }
+
+    if (!tryTrackProcess(pid, m_process_handler.getStartTime(pid), name) && m_has_unresolved_steam
+        && !m_check_timer.isActive())
+    {
+        // Steam was started, but its directory is not ready yet (e.g. on the first run)
+        m_check_timer.start(UNRESOLVED_STEAM_RETRY_INTERVAL);
+    }
+}
+
+void SteamProcessTracker::slotHandleProcessExited(const uint pid)
+{
+    m_non_steam_processes.erase(pid);
+    if (isRunning() && pid == m_data.m_pid)
+    {
+        qCInfo(lc::steam) << "Steam process has exited. PID:" << pid;
+
+        // The process can linger as a zombie for a bit, so make sure the next scan does not pick it up again
+        m_non_steam_processes[pid] = {.m_start_time = m_data.m_start_time, .m_name = {}};
+        clearProcessData();
+
+        // Steam might have already started its replacement
+        slotCheckState();
+    }
+}
+
+void SteamProcessTracker::slotShutdownDeadlineReached()
+{
+    slotCheckState();
+    if (isRunning())
+    {
+        qCWarning(lc::steam) << "Steam did not shut down within the deadline, terminating it! PID:" << m_data.m_pid;
+        m_shutdown_escalated = true;
+        m_process_handler.terminate(m_data.m_pid);
+    }
+}
+
+bool SteamProcessTracker::tryTrackProcess(const uint pid, const QDateTime& start_time, const QString& name)
+{
+    if (!start_time.isValid())
+    {
+        return false;
+    }
 
-        const auto steam_log_dir{m_data.m_steam_dir / "logs"};
-        if (!std::filesystem::exists(steam_log_dir))
+    if (const auto it{m_non_steam_processes.find(pid)}; it != std::end(m_non_steam_processes))
+    {
+        // A process can execute something else without changing its PID or start time
+        const auto& process{it->second};
+        if (process.m_start_time == start_time && (process.m_name.isEmpty() || process.m_name == name))
         {
-            qCInfo(lc::steam) << "Could not resolve steam logs directory for running Steam process, PID:" << pid;
-            continue;
+            return false;
         }
 
-        m_data.m_start_time = m_process_handler.getStartTime(pid);
-        if (!m_data.m_start_time.isValid())
+        m_non_steam_processes.erase(it);
+    }
+
+    // The path might not be readable just yet, so it is not cached
+    const QString exec_path{m_process_handler.getExecPath(pid)};
+    if (exec_path.isEmpty())
+    {
+        return false;
+    }
+
+    // clang-format off
+    static const QRegularExpression exec_regex{
+        R"((?:.+?steam\.exe$))"        // Windows
+        R"(|)"                         // OR
+        R"((?:.*?steam.+?steam$))",    // Linux
+        QRegularExpression::CaseInsensitiveOption};
+    // clang-format on
+
+    if (!exec_path.contains(exec_regex))
+    {
+        // Without the name, the verdict could not tell the process apart from what it executes next
+        if (!name.isEmpty())
         {
-            qCWarning(lc::steam) << "Could not resolve start time for running Steam process! PID:" << pid;
-            break;
+            m_non_steam_processes[pid] = {.m_start_time = start_time, .m_name = name};
         }
+        return false;
+    }
+    qCInfo(lc::steam) << "Found a matching Steam process. PATH:" << exec_path << "| PID:" << pid;
 
-        cleanup.dismiss();
+    auto cleanup{qScopeGuard([this]() { m_data = {}; })};
 
-        m_data.m_pid = pid;
-        m_data.m_log_trackers.reset(new LogTrackers{QTimer{},
-                                                    SteamWebHelperLogTracker{steam_log_dir, m_data.m_start_time},
-                                                    SteamContentLogTracker{steam_log_dir, m_data.m_start_time},
-                                                    SteamGameProcessLogTracker{steam_log_dir, m_data.m_start_time},
-                                                    SteamShaderLogTracker{steam_log_dir, m_data.m_start_time},
-                                                    SteamConnectionLogTracker{steam_log_dir, m_data.m_start_time}});
+    m_data.m_steam_dir = ::getSteamDir(exec_path);
+    if (m_data.m_steam_dir.empty())
+    {
+        m_has_unresolved_steam = true;
+        qCInfo(lc::steam) << "Could not resolve steam directory for running Steam process, PID:" << pid;
+        return false;
+    }
 
-        connect(&m_data.m_log_trackers->m_read_timer, &QTimer::timeout, this, &SteamProcessTracker::slotCheckLogs);
-        m_data.m_log_trackers->m_read_timer.setSingleShot(true);
-        m_data.m_log_trackers->m_read_timer.setInterval(1000);
-        slotCheckLogs();
+    const auto steam_log_dir{m_data.m_steam_dir / "logs"};
+    if (!std::filesystem::exists(steam_log_dir))
+    {
+        m_has_unresolved_steam = true;
+        qCInfo(lc::steam) << "Could not resolve steam logs directory for running Steam process, PID:" << pid;
+        return false;
+    }
+
+    cleanup.dismiss();
 
-        emit signalProcessStateChanged();
-        break;
+    m_data.m_pid        = pid;
+    m_data.m_start_time = start_time;
+    if (m_exit_watcher.watch(pid) != os::ProcessExitWatcher::WatchResult::Watching)
+    {
+        qCDebug(lc::steam) << "Steam process exit cannot be watched, falling back to polling. PID:" << pid;
+    }
+    else if (m_process_handler.isMonitoring())
+    {
+        // Nothing but the exit matters until then, so there is no need to wake up for every process in the system
+        qCDebug(lc::steam) << "Pausing process events while Steam is running.";
+        m_process_handler.stopMonitoring();
     }
+    m_data.m_log_trackers.reset(new LogTrackers{SteamWebHelperLogTracker{steam_log_dir, m_data.m_start_time},
+                                                SteamContentLogTracker{steam_log_dir, m_data.m_start_time},
+                                                SteamGameProcessLogTracker{steam_log_dir, m_data.m_start_time},
+                                                SteamShaderLogTracker{steam_log_dir, m_data.m_start_time},
+                                                SteamConnectionLogTracker{steam_log_dir, m_data.m_start_time},
+                                                SteamLogWatcher{steam_log_dir}});
+
+    auto&      log_trackers{*m_data.m_log_trackers};
+    const auto add_tracker{[this, &log_trackers](SteamLogTracker& tracker)
+                           {
+                               auto checkpoint_file{tracker.getMainFilename().filename()};
+                               checkpoint_file.replace_extension(".json");
+
+                               tracker.setCheckpointFile(m_checkpoint_dir / "checkpoints" / checkpoint_file);
+                               log_trackers.m_log_watcher.addTracker(tracker);
+                           }};
+
+    add_tracker(log_trackers.m_web_helper);
+    add_tracker(log_trackers.m_content_log);
+    add_tracker(log_trackers.m_gameprocess_log);
+    add_tracker(log_trackers.m_shader_log);
+    add_tracker(log_trackers.m_connection_log);
+    log_trackers.m_log_watcher.slotCheckAllLogs();
+
+    emit signalProcessStateChanged();
+    return true;
 }
 
-void SteamProcessTracker::slotCheckLogs()
+void SteamProcessTracker::clearProcessData()
 {
-    if (m_data.m_log_trackers)
+    if (m_shutdown_elapsed.isValid())
     {
-        m_data.m_log_trackers->m_read_timer.stop();
-        const auto auto_start_timer{qScopeGuard([this]() { m_data.m_log_trackers->m_read_timer.start(); })};
+        qCInfo(lc::steam).nospace() << "Steam shut down in " << m_shutdown_elapsed.elapsed() << " ms"
+                                    << (m_shutdown_escalated ? " after being terminated." : ".");
+        m_shutdown_deadline_timer.stop();
+        m_shutdown_elapsed.invalidate();
+        m_shutdown_escalated = false;
+    }
+
+    m_exit_watcher.unwatch(m_data.m_pid);
+    m_data = {};
 
-        m_data.m_log_trackers->m_web_helper.slotCheckLog();
-        m_data.m_log_trackers->m_content_log.slotCheckLog();
-        m_data.m_log_trackers->m_gameprocess_log.slotCheckLog();
-        m_data.m_log_trackers->m_shader_log.slotCheckLog();
-        m_data.m_log_trackers->m_connection_log.slotCheckLog();
+    if (m_process_events_available && !m_process_handler.isMonitoring())
+    {
+        m_process_events_available = m_process_handler.startMonitoring();
+        if (!m_process_events_available)
+        {
+            qCWarning(lc::steam) << "Process events are no longer available, Steam process will be searched for "
+                                    "periodically.";
+        }
     }
+
+    emit signalProcessStateChanged();
 }
 }  // namespace steam
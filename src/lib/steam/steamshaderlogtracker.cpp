@@ -6,6 +6,7 @@
 
 // local includes
 #include "common/loggingcategories.h"
+#include "json/json.h"
 
 namespace steam
 {
@@ -20,20 +21,21 @@ bool SteamShaderLogTracker::isAppCompilingShaders(const AppId& app_id) const
     return m_apps_with_compiling_shaders.contains(app_id);
 }
 
-void SteamShaderLogTracker::onLogChanged(const std::vector<QString>& new_lines)
+void SteamShaderLogTracker::onLogChanged(const std::vector<QByteArrayView>& new_lines)
 {
     std::map<AppId, bool> new_shader_states;
-    for (const QString& line : new_lines)
+    for (const QByteArrayView raw_line : new_lines)
     {
-        static const QRegularExpression regex{
+        static const LinePattern pattern{
+            {"processing job", "compile job"},
             R"((?:Starting processing job for app (\d+))|(?:Destroyed compile job (\d+)))"};
-        if (const auto match{regex.match(line)}; match.hasMatch())
+        if (const auto match{matchLine(pattern, raw_line)}; match.hasMatch())
         {
             const bool started{match.hasCaptured(1)};
             const auto app_id{AppId::fromString(started ? match.captured(1) : match.captured(2))};
             if (!app_id)
             {
-                qCWarning(lc::steam) << "Failed to get AppID from" << line;
+                qCWarning(lc::steam) << "Failed to get AppID from" << QString::fromUtf8(raw_line);
                 continue;
             }
 
@@ -50,6 +52,7 @@ void SteamShaderLogTracker::onLogChanged(const std::vector<QString>& new_lines)
             {
                 m_apps_with_compiling_shaders.insert(app_id);
                 qCInfo(lc::steam) << "Compiling shaders for AppID:" << app_id.getId();
+                emit signalShaderCompilationChanged(app_id, state);
             }
         }
         else
@@ -58,8 +61,38 @@ void SteamShaderLogTracker::onLogChanged(const std::vector<QString>& new_lines)
             {
                 m_apps_with_compiling_shaders.erase(data_it);
                 qCInfo(lc::steam) << "Stopped compiling shaders for AppID:" << app_id.getId();
+                emit signalShaderCompilationChanged(app_id, state);
             }
         }
     }
 }
+
+QString SteamShaderLogTracker::saveState() const
+{
+    std::vector<std::uint64_t> app_ids;
+    for (const auto& app_id : m_apps_with_compiling_shaders)
+    {
+        app_ids.push_back(app_id.getId());
+    }
+
+    return json::toJson(app_ids).value_or(QString{});
+}
+
+bool SteamShaderLogTracker::restoreState(const QString& state)
+{
+    const auto app_ids{json::fromJson<std::vector<std::uint64_t>>(state)};
+    if (!app_ids)
+    {
+        return false;
+    }
+
+    std::set<AppId> apps_with_compiling_shaders;
+    for (const auto app_id : *app_ids)
+    {
+        apps_with_compiling_shaders.insert(AppId{app_id});
+    }
+
+    m_apps_with_compiling_shaders = std::move(apps_with_compiling_shaders);
+    return true;
+}
 }  // namespace steam
@@ -6,6 +6,7 @@
 
 // local includes
 #include "common/loggingcategories.h"
+#include "json/json.h"
 
 namespace steam
 {
@@ -21,14 +22,15 @@ enums::SteamUiMode SteamWebHelperLogTracker::getSteamUiMode() const
     return m_ui_mode;
 }
 
-void SteamWebHelperLogTracker::onLogChanged(const std::vector<QString>& new_lines)
+void SteamWebHelperLogTracker::onLogChanged(const std::vector<QByteArrayView>& new_lines)
 {
     enums::SteamUiMode new_ui_mode{m_ui_mode};
-    for (const QString& line : new_lines)
+    for (const QByteArrayView raw_line : new_lines)
     {
-        static const QRegularExpression initial_regex{R"(SP\s(?:(Desktop)|(BPM))_)"};
-        static const QRegularExpression default_regex{R"(SP\s(?:(Desktop)|(BPM))_.+?WasHidden\s(?:(0)|(1)))"};
-        const auto match{(new_ui_mode == enums::SteamUiMode::Unknown ? initial_regex : default_regex).match(line)};
+        static const LinePattern initial_pattern{{"SP"}, R"(SP\s(?:(Desktop)|(BPM))_)"};
+        static const LinePattern default_pattern{{"WasHidden"}, R"(SP\s(?:(Desktop)|(BPM))_.+?WasHidden\s(?:(0)|(1)))"};
+        const auto               match{
+            matchLine(new_ui_mode == enums::SteamUiMode::Unknown ? initial_pattern : default_pattern, raw_line)};
         if (match.hasMatch())
         {
             constexpr int desktop_group{1};
@@ -64,6 +66,28 @@ void SteamWebHelperLogTracker::onLogChanged(const std::vector<QString>& new_line
         qCInfo(lc::steam) << "Steam UI mode change:" << enums::qEnumToString(m_ui_mode) << "->"
                           << enums::qEnumToString(new_ui_mode);
         m_ui_mode = new_ui_mode;
+        emit signalSteamUiModeChanged();
     }
 }
+
+QString SteamWebHelperLogTracker::saveState() const
+{
+    return json::toJson(m_ui_mode).value_or(QString{});
+}
+
+bool SteamWebHelperLogTracker::restoreState(const QString& state)
+{
+    const auto ui_mode{json::fromJson<enums::SteamUiMode>(state)};
+    if (!ui_mode)
+    {
+        return false;
+    }
+
+    if (m_ui_mode != *ui_mode)
+    {
+        m_ui_mode = *ui_mode;
+        emit signalSteamUiModeChanged();
+    }
+    return true;
+}
 }  // namespace steam
@@ -0,0 +1,219 @@
+// system/Qt includes
+#include <QElapsedTimer>
+#include <QTest>
+#include <QTimeZone>
+#include <algorithm>
+
+// local includes
+#include "steam/shortcutsvdf.h"
+
+namespace
+{
+class BinaryVdfWriter
+{
+public:
+    BinaryVdfWriter& beginMap(const QByteArray& key)
+    {
+        m_data.append('\x00').append(key).append('\0');
+        return *this;
+    }
+
+    BinaryVdfWriter& endMap()
+    {
+        m_data.append('\x08');
+        return *this;
+    }
+
+    BinaryVdfWriter& addString(const QByteArray& key, const QByteArray& value)
+    {
+        m_data.append('\x01').append(key).append('\0').append(value).append('\0');
+        return *this;
+    }
+
+    BinaryVdfWriter& addInt32(const QByteArray& key, const std::uint32_t value)
+    {
+        m_data.append('\x02').append(key).append('\0');
+        for (int i = 0; i < 4; ++i)
+        {
+            m_data.append(static_cast<char>((value >> (8U * static_cast<unsigned int>(i))) & 0xFFU));
+        }
+        return *this;
+    }
+
+    const QByteArray& getData() const
+    {
+        return m_data;
+    }
+
+private:
+    QByteArray m_data;
+};
+
+void addShortcut(BinaryVdfWriter& writer, const int index, const std::uint32_t app_id)
+{
+    const auto name{QByteArray::number(index)};
+    writer.beginMap(name)
+        .addInt32("appid", app_id)
+        .addString("AppName", "Game " + name)
+        .addString("Exe", "\"/usr/bin/game" + name + "\"")
+        .addString("StartDir", "\"/usr/bin/\"")
+        .addString("icon", "")
+        .addString("LaunchOptions", "--fullscreen")
+        .addInt32("IsHidden", 0)
+        .addInt32("LastPlayTime", 1700000000)
+        .beginMap("tags")
+        .addString("0", "favorite")
+        .endMap()
+        .endMap();
+}
+}  // namespace
+
+class ShortcutsVdfTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsesAssociatedFields();
+    void skipsEntriesWithoutAppId();
+    void rejectsMalformedData();
+    void rejectsDeeplyNestedMaps();
+    void benchmarkParse();
+};
+
+void ShortcutsVdfTest::parsesAssociatedFields()
+{
+    BinaryVdfWriter writer;
+    writer.beginMap("shortcuts")
+        .beginMap("0")
+        .addInt32("appid", 0x80000001)
+        .addString("AppName", "With start dir")
+        .addString("StartDir", "/games/first")
+        .addString("Exe", "/games/first/run")
+        .addString("LaunchOptions", "-windowed")
+        .addString("icon", "/games/first/icon.png")
+        .addInt32("LastPlayTime", 1700000000)
+        .beginMap("tags")
+        .addString("0", "favorite")
+        .addString("1", "emulator")
+        .endMap()
+        .endMap()
+        .beginMap("1")
+        .addString("appname", "Without start dir")
+        .addInt32("AppId", 0x80000002)
+        .addString("exe", "/games/second/run")
+        .addInt32("LastPlayTime", 0)
+        .endMap()
+        .endMap()
+        .endMap();
+
+    const auto entries{steam::ShortcutsVdfEntry::scrapeShortcutsVdf(writer.getData())};
+    QVERIFY(entries);
+    QCOMPARE(entries->size(), std::size_t{2});
+
+    const auto& first{entries->at(0)};
+    QVERIFY(first.m_app_id == steam::AppId{0x80000001});
+    QCOMPARE(first.m_app_name, QString{"With start dir"});
+    QCOMPARE(first.m_start_dir, QString{"/games/first"});
+    QCOMPARE(first.m_exe, QString{"/games/first/run"});
+    QCOMPARE(first.m_launch_options, QString{"-windowed"});
+    QCOMPARE(first.m_icon, QString{"/games/first/icon.png"});
+    QCOMPARE(first.m_tags, (std::vector<QString>{"favorite", "emulator"}));
+    QCOMPARE(first.m_last_play_time, QDateTime::fromSecsSinceEpoch(1700000000, QTimeZone::UTC));
+
+    const auto& second{entries->at(1)};
+    QVERIFY(second.m_app_id == steam::AppId{0x80000002});
+    QCOMPARE(second.m_app_name, QString{"Without start dir"});
+    QVERIFY(second.m_start_dir.isEmpty());
+    QCOMPARE(second.m_exe, QString{"/games/second/run"});
+    QVERIFY(second.m_tags.empty());
+    QVERIFY(!second.m_last_play_time.isValid());
+}
+
+void ShortcutsVdfTest::skipsEntriesWithoutAppId()
+{
+    BinaryVdfWriter writer;
+    writer.beginMap("shortcuts")
+        .beginMap("0")
+        .addString("AppName", "No app id")
+        .endMap()
+        .beginMap("1")
+        .addInt32("appid", 0x80000003)
+        .addString("AppName", "With app id")
+        .endMap()
+        .endMap()
+        .endMap();
+
+    const auto entries{steam::ShortcutsVdfEntry::scrapeShortcutsVdf(writer.getData())};
+    QVERIFY(entries);
+    QCOMPARE(entries->size(), std::size_t{1});
+    QCOMPARE(entries->front().m_app_name, QString{"With app id"});
+}
+
+void ShortcutsVdfTest::rejectsMalformedData()
+{
+    BinaryVdfWriter writer;
+    writer.beginMap("shortcuts");
+    addShortcut(writer, 0, 0x80000004);
+    writer.endMap().endMap();
+
+    const auto& data{writer.getData()};
+    QVERIFY(steam::ShortcutsVdfEntry::scrapeShortcutsVdf(data));
+    QVERIFY(!steam::ShortcutsVdfEntry::scrapeShortcutsVdf(QByteArray{}));
+    QVERIFY(!steam::ShortcutsVdfEntry::scrapeShortcutsVdf(BinaryVdfWriter{}.beginMap("other").endMap().getData()));
+
+    // Every truncation has to be detected instead of reading past the end
+    for (qsizetype size = 1; size < data.size(); ++size)
+    {
+        QVERIFY2(!steam::ShortcutsVdfEntry::scrapeShortcutsVdf(data.first(size)), qPrintable(QString::number(size)));
+    }
+}
+
+void ShortcutsVdfTest::rejectsDeeplyNestedMaps()
+{
+    constexpr int depth{1000};
+
+    BinaryVdfWriter writer;
+    writer.beginMap("shortcuts").beginMap("0").addInt32("appid", 0x80000005);
+    for (int i = 0; i < depth; ++i)
+    {
+        writer.beginMap("nested");
+    }
+    for (int i = 0; i < depth; ++i)
+    {
+        writer.endMap();
+    }
+    writer.endMap().endMap().endMap();
+
+    QVERIFY(!steam::ShortcutsVdfEntry::scrapeShortcutsVdf(writer.getData()));
+}
+
+void ShortcutsVdfTest::benchmarkParse()
+{
+    constexpr int entry_count{10000};
+    constexpr int iterations{20};
+
+    BinaryVdfWriter writer;
+    writer.beginMap("shortcuts");
+    for (int i = 0; i < entry_count; ++i)
+    {
+        addShortcut(writer, i, 0x80000000U | static_cast<std::uint32_t>(i));
+    }
+    writer.endMap().endMap();
+
+    const auto&   data{writer.getData()};
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto entries{steam::ShortcutsVdfEntry::scrapeShortcutsVdf(data)};
+        QVERIFY(entries);
+        QCOMPARE(entries->size(), static_cast<std::size_t>(entry_count));
+    }
+
+    const auto elapsed_ns{std::max(qint64{1}, timer.nsecsElapsed())};
+    QTest::setBenchmarkResult(static_cast<qreal>(data.size()) * iterations * 1e9 / static_cast<qreal>(elapsed_ns),
+                              QTest::BytesPerSecond);
+}
+
+QTEST_GUILESS_MAIN(ShortcutsVdfTest)
+#include "shortcutsvdftest.moc"
@@ -0,0 +1,327 @@
+// system/Qt includes
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTest>
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+// local includes
+#include "steam/steamlogtracker.h"
+
+namespace
+{
+class LineCollector : public steam::SteamLogTracker
+{
+public:
+    explicit LineCollector(const QString& main_filename, const QString& backup_filename,
+                           const QDateTime& first_entry_time_filter = {}, const bool keep_lines = true)
+        : SteamLogTracker{main_filename.toStdString(), backup_filename.toStdString(), first_entry_time_filter}
+        , m_keep_lines{keep_lines}
+    {
+    }
+
+    std::vector<QByteArray> takeLines()
+    {
+        return std::exchange(m_lines, {});
+    }
+
+    quint64 getLineCount() const
+    {
+        return m_line_count;
+    }
+
+protected:
+    void onLogChanged(const std::vector<QByteArrayView>& new_lines) override
+    {
+        m_line_count += new_lines.size();
+        if (m_keep_lines)
+        {
+            for (const auto& line : new_lines)
+            {
+                m_lines.emplace_back(line.toByteArray());
+            }
+        }
+    }
+
+    QString saveState() const override
+    {
+        return {};
+    }
+
+    bool restoreState(const QString&) override
+    {
+        return true;
+    }
+
+private:
+    bool                    m_keep_lines;
+    quint64                 m_line_count{0};
+    std::vector<QByteArray> m_lines;
+};
+
+void writeFile(const QString& filename, const QByteArray& data, const bool append = false)
+{
+    QFile file{filename};
+    QVERIFY(file.open(append ? QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(data), data.size());
+}
+
+QByteArray makeContentLogLine(const int index)
+{
+    // Mimics the lines of content_log.txt, which is the most verbose of the tracked logs
+    return "[2024-05-01 12:" + QByteArray::number(index / 60 % 60).rightJustified(2, '0') + ":"
+           + QByteArray::number(index % 60).rightJustified(2, '0') + "] AppID " + QByteArray::number(index % 1000)
+           + " state changed : Update Required,Update Queued,Update Running,Update Started,\n";
+}
+
+QByteArray makeTimedLine(const QTime& time, const QByteArray& text)
+{
+    return "[2024-05-01 " + time.toString("hh:mm:ss").toLatin1() + "] " + text + "\n";
+}
+
+QDateTime makeFilterTime(const QTime& time)
+{
+    return QDateTime{QDate{2024, 5, 1}, time};
+}
+
+std::optional<qint64> getPeakMemoryKb()
+{
+    QFile file{"/proc/self/status"};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+
+    static const QRegularExpression regex{R"(VmHWM:\s+(\d+)\s+kB)"};
+    const auto                      match{regex.match(QString::fromLatin1(file.readAll()))};
+    if (!match.hasMatch())
+    {
+        return std::nullopt;
+    }
+
+    return match.captured(1).toLongLong();
+}
+
+void resetPeakMemory()
+{
+    // Supported since Linux 4.0, the peak is simply not reset otherwise
+    QFile file{"/proc/self/clear_refs"};
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write("5");
+    }
+}
+}  // namespace
+
+class SteamLogTrackerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readsCompleteLinesOnly();
+    void skipsCarriageReturnsAndEmptyLines();
+    void readsLinesAcrossChunks();
+    void readsBackupAfterSwitch();
+    void benchmarkInitialRead();
+    void startsAtFirstEntryAfterFilter();
+    void startsInBackupFileAfterFilter();
+    void waitsForEntriesAfterFilter();
+    void initialReadMemoryDoesNotDependOnLogSize();
+
+private:
+    QString getFilePath(const QString& filename) const;
+
+    QTemporaryDir m_dir;
+};
+
+void SteamLogTrackerTest::readsCompleteLinesOnly()
+{
+    const auto main_file{getFilePath("complete.txt")};
+    writeFile(main_file, "first\nsecond\nincompl");
+
+    LineCollector tracker{main_file, getFilePath("complete.previous.txt")};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{"first", "second"}));
+
+    writeFile(main_file, "ete\n", true);
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{"incomplete"}));
+
+    QVERIFY(!tracker.checkLog());
+    QVERIFY(tracker.takeLines().empty());
+}
+
+void SteamLogTrackerTest::skipsCarriageReturnsAndEmptyLines()
+{
+    const auto main_file{getFilePath("crlf.txt")};
+    writeFile(main_file, "first\r\n\r\n\nsecond\n");
+
+    LineCollector tracker{main_file, getFilePath("crlf.previous.txt")};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{"first", "second"}));
+}
+
+void SteamLogTrackerTest::readsLinesAcrossChunks()
+{
+    // Large enough to be handed over in several chunks
+    constexpr int line_count{10000};
+
+    std::vector<QByteArray> expected_lines;
+    QByteArray              data;
+    for (int i = 0; i < line_count; ++i)
+    {
+        const auto line{makeContentLogLine(i)};
+        expected_lines.emplace_back(line.chopped(1));
+        data.append(line);
+    }
+
+    const auto main_file{getFilePath("chunks.txt")};
+    writeFile(main_file, data);
+
+    LineCollector tracker{main_file, getFilePath("chunks.previous.txt")};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), expected_lines);
+}
+
+void SteamLogTrackerTest::readsBackupAfterSwitch()
+{
+    const auto main_file{getFilePath("switch.txt")};
+    const auto backup_file{getFilePath("switch.previous.txt")};
+    writeFile(main_file, "first\nsecond\n");
+
+    LineCollector tracker{main_file, backup_file};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{"first", "second"}));
+
+    // Steam moves the full log to the backup file and starts a new one
+    writeFile(main_file, "third", true);
+    QVERIFY(QFile::rename(main_file, backup_file));
+    writeFile(main_file, "4th\n");
+
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{"third", "4th"}));
+}
+
+void SteamLogTrackerTest::benchmarkInitialRead()
+{
+    constexpr int line_count{200000};
+    constexpr int iterations{10};
+
+    QByteArray data;
+    for (int i = 0; i < line_count; ++i)
+    {
+        data.append(makeContentLogLine(i));
+    }
+
+    const auto main_file{getFilePath("benchmark.txt")};
+    writeFile(main_file, data);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        LineCollector tracker{main_file, getFilePath("benchmark.previous.txt"), {}, false};
+        QVERIFY(tracker.checkLog());
+        QCOMPARE(tracker.getLineCount(), static_cast<quint64>(line_count));
+    }
+
+    const auto elapsed_ns{std::max(qint64{1}, timer.nsecsElapsed())};
+    QTest::setBenchmarkResult(static_cast<qreal>(data.size()) * iterations * 1e9 / static_cast<qreal>(elapsed_ns),
+                              QTest::BytesPerSecond);
+}
+
+void SteamLogTrackerTest::startsAtFirstEntryAfterFilter()
+{
+    const auto main_file{getFilePath("seek.txt")};
+    writeFile(main_file, makeTimedLine(QTime{10, 0}, "old") + "old continuation\n" + makeTimedLine(QTime{10, 1}, "old")
+                             + makeTimedLine(QTime{10, 2}, "new") + "new continuation\n"
+                             + makeTimedLine(QTime{10, 3}, "new"));
+
+    LineCollector tracker{main_file, getFilePath("seek.previous.txt"), makeFilterTime(QTime{10, 2})};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(),
+             (std::vector<QByteArray>{makeTimedLine(QTime{10, 2}, "new").chopped(1), "new continuation",
+                                      makeTimedLine(QTime{10, 3}, "new").chopped(1)}));
+}
+
+void SteamLogTrackerTest::startsInBackupFileAfterFilter()
+{
+    const auto main_file{getFilePath("backup_seek.txt")};
+    const auto backup_file{getFilePath("backup_seek.previous.txt")};
+    writeFile(backup_file, makeTimedLine(QTime{9, 0}, "old") + makeTimedLine(QTime{9, 1}, "new"));
+    writeFile(main_file, makeTimedLine(QTime{9, 2}, "newer"));
+
+    LineCollector tracker{main_file, backup_file, makeFilterTime(QTime{9, 1})};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{makeTimedLine(QTime{9, 1}, "new").chopped(1),
+                                                           makeTimedLine(QTime{9, 2}, "newer").chopped(1)}));
+}
+
+void SteamLogTrackerTest::waitsForEntriesAfterFilter()
+{
+    const auto main_file{getFilePath("wait_seek.txt")};
+    const auto backup_file{getFilePath("wait_seek.previous.txt")};
+    writeFile(backup_file, makeTimedLine(QTime{8, 0}, "old"));
+    writeFile(main_file, makeTimedLine(QTime{8, 1}, "old"));
+
+    LineCollector tracker{main_file, backup_file, makeFilterTime(QTime{8, 2})};
+    QVERIFY(tracker.checkLog());
+    QVERIFY(tracker.takeLines().empty());
+
+    writeFile(main_file, makeTimedLine(QTime{8, 1}, "late") + makeTimedLine(QTime{8, 2}, "new"), true);
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{makeTimedLine(QTime{8, 2}, "new").chopped(1)}));
+}
+
+void SteamLogTrackerTest::initialReadMemoryDoesNotDependOnLogSize()
+{
+    constexpr qint64 backup_size{64 * 1024 * 1024};
+    constexpr qint64 max_peak_growth_kb{16 * 1024};
+
+    // The data is written in small batches, so that generating it does not raise the peak by itself
+    const auto main_file{getFilePath("memory.txt")};
+    const auto backup_file{getFilePath("memory.previous.txt")};
+    writeFile(backup_file, {});
+    for (qint64 written{0}; written < backup_size;)
+    {
+        QByteArray batch;
+        for (int i = 0; i < 1000; ++i)
+        {
+            batch.append(makeTimedLine(QTime{7, 0}, "old entry that will not be read"));
+        }
+
+        writeFile(backup_file, batch, true);
+        written += batch.size();
+    }
+    writeFile(main_file, makeTimedLine(QTime{7, 1}, "new"));
+
+    resetPeakMemory();
+    const auto peak_before{getPeakMemoryKb()};
+    if (!peak_before)
+    {
+        QSKIP("The peak memory usage is not available on this platform");
+    }
+
+    LineCollector tracker{main_file, backup_file, makeFilterTime(QTime{7, 1})};
+    QVERIFY(tracker.checkLog());
+    QCOMPARE(tracker.takeLines(), (std::vector<QByteArray>{makeTimedLine(QTime{7, 1}, "new").chopped(1)}));
+
+    const auto peak_after{getPeakMemoryKb()};
+    QVERIFY(peak_after);
+
+    const auto peak_growth_kb{*peak_after - *peak_before};
+    qInfo() << "peak RSS growth during the initial read of a" << (backup_size / 1024 / 1024) << "MiB log:"
+            << peak_growth_kb << "kB";
+    QVERIFY2(peak_growth_kb < max_peak_growth_kb, qPrintable(QString::number(peak_growth_kb) + " kB"));
+}
+
+QString SteamLogTrackerTest::getFilePath(const QString& filename) const
+{
+    return m_dir.filePath(filename);
+}
+
+QTEST_GUILESS_MAIN(SteamLogTrackerTest)
+#include "steamlogtrackertest.moc"
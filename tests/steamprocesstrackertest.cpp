@@ -0,0 +1,51 @@
+// system/Qt includes
+#include <QTemporaryDir>
+#include <QTest>
+
+// local includes
+#include "os/processhandler.h"
+#include "steam/steamprocesstracker.h"
+
+class SteamProcessTrackerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchmarkColdScan();
+    void benchmarkCachedScan();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void SteamProcessTrackerTest::initTestCase()
+{
+    // The live process table is scanned, so the numbers depend on how busy the machine is
+    qInfo() << "scanning" << os::ProcessHandler{}.getPids().size() << "processes";
+}
+
+void SteamProcessTrackerTest::benchmarkColdScan()
+{
+    // Every process has to be resolved and matched (the tracker construction is measured too)
+    QBENCHMARK
+    {
+        steam::SteamProcessTracker tracker{m_dir.path().toStdString()};
+        tracker.slotCheckState();
+    }
+}
+
+void SteamProcessTrackerTest::benchmarkCachedScan()
+{
+    // Only the processes that were started since the previous scan have to be resolved
+    steam::SteamProcessTracker tracker{m_dir.path().toStdString()};
+    tracker.slotCheckState();
+
+    QBENCHMARK
+    {
+        tracker.slotCheckState();
+    }
+}
+
+QTEST_GUILESS_MAIN(SteamProcessTrackerTest)
+#include "steamprocesstrackertest.moc"